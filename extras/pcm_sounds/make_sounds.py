@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+Generates mando-blaster/pcm_sounds.h, the sound effects used by the PCM audio
+back end (ENABLE_EASY_AUDIO_PCM).
+
+Each effect is signed 8 bit mono at 8kHz, stored in PROGMEM. By default the
+effects are synthesised, any of them can be replaced with a WAV file:
+
+  python3 make_sounds.py                          # synthesised effects
+  python3 make_sounds.py fire_a=pew.wav stun_a=zap.wav
+
+WAV files can be 8 or 16 bit, mono or stereo, at any rate. They are mixed down
+to mono and resampled to 8kHz. Keep them short, every second costs 8KB of flash.
+"""
+import math
+import os
+import random
+import struct
+import sys
+import wave
+
+RATE = 8000
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "mando-blaster", "pcm_sounds.h")
+
+# name, track constant from config.h, description
+SOUNDS = [
+    ("start_up", "AUDIO_TRACK_START_UP", "rising power up sweep"),
+    ("change_mode", "AUDIO_TRACK_AMMO_CHANGE_MODE", "two tone chirp"),
+    ("fire_a", "AUDIO_TRACK_AMMO_FIRE_A", "falling blaster sweep"),
+    ("fire_b", "AUDIO_TRACK_AMMO_FIRE_B", "falling blaster sweep, higher"),
+    ("stun_a", "AUDIO_TRACK_AMMO_STUN_A", "warbling stun buzz"),
+    ("stun_b", "AUDIO_TRACK_AMMO_STUN_B", "warbling stun buzz, lower"),
+    ("reload", "AUDIO_TRACK_AMMO_RELOAD", "noise burst and clunk"),
+    ("empty", "AUDIO_TRACK_AMMO_EMPTY", "dry fire click"),
+]
+
+
+def sweep(duration, f0, f1, decay, noise=0.0):
+    out, phase = [], 0.0
+    n = int(duration * RATE)
+    for i in range(n):
+        t = i / n
+        f = f0 * (f1 / f0) ** t
+        phase += 2 * math.pi * f / RATE
+        env = math.exp(-decay * t) * min(1.0, i / 40.0)
+        s = math.sin(phase) + noise * random.uniform(-1, 1) * (1 - t)
+        out.append(env * s)
+    return out
+
+
+def buzz(duration, freq, wobble):
+    out, phase = [], 0.0
+    n = int(duration * RATE)
+    for i in range(n):
+        t = i / n
+        f = freq * (1 + 0.15 * math.sin(2 * math.pi * wobble * i / RATE))
+        phase += 2 * math.pi * f / RATE
+        env = (1 - t) * min(1.0, i / 40.0)
+        out.append(env * (0.6 if math.sin(phase) > 0 else -0.6))
+    return out
+
+
+def chirp():
+    return sweep(0.05, 800, 800, 1.0) + sweep(0.07, 1200, 1200, 3.0)
+
+
+def click(duration, decay):
+    n = int(duration * RATE)
+    return [math.exp(-decay * i / n) * random.uniform(-1, 1) for i in range(n)]
+
+
+def synthesise(name):
+    return {
+        "start_up": lambda: sweep(0.35, 200, 1500, 1.5),
+        "change_mode": chirp,
+        "fire_a": lambda: sweep(0.15, 1800, 300, 3.0, 0.3),
+        "fire_b": lambda: sweep(0.15, 2200, 400, 3.0, 0.3),
+        "stun_a": lambda: buzz(0.2, 600, 40),
+        "stun_b": lambda: buzz(0.2, 450, 30),
+        "reload": lambda: click(0.15, 4.0) + sweep(0.1, 120, 80, 5.0),
+        "empty": lambda: click(0.04, 8.0),
+    }[name]()
+
+
+def load_wav(path):
+    with wave.open(path, "rb") as w:
+        channels, width, rate = w.getnchannels(), w.getsampwidth(), w.getframerate()
+        raw = w.readframes(w.getnframes())
+    if width == 1:
+        values = [(b - 128) / 128.0 for b in raw]
+    elif width == 2:
+        values = [v / 32768.0 for v in struct.unpack("<%dh" % (len(raw) // 2), raw)]
+    else:
+        sys.exit("%s: only 8 and 16 bit WAV files are supported" % path)
+    mono = [sum(values[i:i + channels]) / channels for i in range(0, len(values), channels)]
+    # linear resample to 8kHz
+    n = int(len(mono) * RATE / rate)
+    out = []
+    for i in range(n):
+        pos = i * rate / RATE
+        j = int(pos)
+        frac = pos - j
+        nxt = mono[j + 1] if j + 1 < len(mono) else mono[j]
+        out.append(mono[j] * (1 - frac) + nxt * frac)
+    return out
+
+
+def to_int8(samples):
+    return [max(-127, min(127, int(round(s * 127)))) for s in samples]
+
+
+def main(args):
+    random.seed(1)
+    files = {}
+    for arg in args:
+        name, _, path = arg.partition("=")
+        if name not in [s[0] for s in SOUNDS] or not path:
+            sys.exit(__doc__)
+        files[name] = path
+
+    lines = [
+        "#ifndef pcm_sounds_h",
+        "#define pcm_sounds_h",
+        "",
+        "/**",
+        " * Sound effects for the PCM audio back end, signed 8 bit mono at 8kHz.",
+        " * Generated by extras/pcm_sounds/make_sounds.py - DO NOT EDIT",
+        " */",
+        "",
+    ]
+    total = 0
+    for name, track, description in SOUNDS:
+        data = to_int8(load_wav(files[name]) if name in files else synthesise(name))
+        total += len(data)
+        source = os.path.basename(files[name]) if name in files else description
+        lines.append("// %s - %s, %d ms" % (name, source, len(data) * 1000 // RATE))
+        lines.append("static const int8_t PCM_%s[] PROGMEM = {" % name.upper())
+        for i in range(0, len(data), 16):
+            lines.append("  " + ", ".join("%d" % v for v in data[i:i + 16]) + ",")
+        lines.append("};")
+        lines.append("")
+
+    lines.append("// %d bytes of samples" % total)
+    lines.append("static const EasyPcmSound PCM_SOUNDS[] PROGMEM = {")
+    for name, track, _ in SOUNDS:
+        lines.append("  {%s, PCM_%s, sizeof(PCM_%s)}," % (track, name.upper(), name.upper()))
+    lines.append("};")
+    lines.append("static const uint8_t PCM_SOUND_COUNT = sizeof(PCM_SOUNDS) / sizeof(PCM_SOUNDS[0]);")
+    lines.append("")
+    lines.append("#endif")
+
+    with open(OUTPUT, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("wrote %s, %d bytes of samples" % (os.path.normpath(OUTPUT), total))
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
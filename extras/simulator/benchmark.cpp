@@ -0,0 +1,282 @@
+/*
+ * name:  benchmark.cpp
+ * Description: Trigger-to-sound and trigger-to-light latency of the blaster
+ *              sketch, measured on the virtual clock.
+ *
+ * Each trigger edge is injected at a random phase relative to the main loop.
+ * Sound latency runs from the edge to the first byte of the play command that
+ * follows it, or on PCM builds to the first sample of the effect, which the mixer
+ * reports from the main loop and is dated back to within a sample. Light latency
+ * runs from the edge to the first FastLED.show() with every pixel white, for the
+ * shots only. A shot that lands while the strip is
+ * still white, eg. at the end of the stun fade, has no flash to see and is left
+ * out of the light figures. Presses are grouped into paths by the track they play:
+ *   fire        - AUDIO_TRACK_AMMO_FIRE_A/B
+ *   stun        - AUDIO_TRACK_AMMO_STUN_A/B
+ *   empty-clip  - AUDIO_TRACK_AMMO_EMPTY
+ *   mode-change - AUDIO_TRACK_AMMO_CHANGE_MODE, measured from the release edge
+ * The CPU time spent writing to the audio port is reported too, it depends on
+ * the AUDIO_SERIAL the build uses.
+ *
+ * Then the trigger is held in the first full auto mode of AMMO_MODES until the
+ * clip runs dry or the barrel overheats, many times. Each shot has to tick the
+ * counter, start a fire track and flash the strip. The report compares the three
+ * counts, and gives the gaps between fire tracks, which grow with the heat, and
+ * the time from each track to its flash.
+ */
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "sim.h"
+#include <Arduino.h>
+#include "config.h"
+#include "easycounter.h"
+#include "easyheat.h"
+#if ENABLE_EASY_AUDIO_PCM == 1
+#include "easyaudio.h"
+extern EasyAudio audio;
+#endif
+
+static const int PATH_FIRE = 0;
+static const int PATH_STUN = 1;
+static const int PATH_EMPTY = 2;
+static const int PATH_MODE = 3;
+static const int PATH_COUNT = 4;
+static const char* PATH_NAMES[PATH_COUNT] = {"fire", "stun", "empty-clip", "mode-change"};
+
+struct sample {
+  uint64_t pressEdge = 0;
+  uint64_t releaseEdge = 0;
+  int path = -1;
+  int64_t sound = -1;
+  int64_t light = -1;
+};
+
+static std::vector<uint64_t> _sound[PATH_COUNT];
+static std::vector<uint64_t> _light[PATH_COUNT];
+static sample _current;
+static bool _active = false;
+static bool _stripWhite = false;    // the last show had every pixel white
+
+// full auto holds
+extern uint8_t selectedTriggerMode;
+extern EasyCounter ammoCounter;
+extern EasyHeat heat;
+static bool _autoHold = false;
+static std::vector<uint64_t> _autoTracks;
+static std::vector<uint64_t> _autoFlashes;
+
+static int pathForTrack(uint16_t track) {
+  if (track == AUDIO_TRACK_AMMO_FIRE_A || track == AUDIO_TRACK_AMMO_FIRE_B) return PATH_FIRE;
+  if (track == AUDIO_TRACK_AMMO_STUN_A || track == AUDIO_TRACK_AMMO_STUN_B) return PATH_STUN;
+  if (track == AUDIO_TRACK_AMMO_EMPTY) return PATH_EMPTY;
+  if (track == AUDIO_TRACK_AMMO_CHANGE_MODE) return PATH_MODE;
+  return -1;
+}
+
+static void finishSample() {
+  if (_active && _current.path >= 0) {
+    if (_current.sound >= 0) _sound[_current.path].push_back(_current.sound);
+    bool shot = _current.path == PATH_FIRE || _current.path == PATH_STUN;
+    if (shot && _current.light >= 0) _light[_current.path].push_back(_current.light);
+  }
+  _current = sample();
+  _active = false;
+}
+
+static void onTrack(uint16_t track, uint64_t t) {
+  int path = pathForTrack(track);
+  if (_autoHold && path == PATH_FIRE) _autoTracks.push_back(t);
+  if (!_active) return;
+  if (path == PATH_MODE) {
+    // the change mode track follows the release, the press itself may have fired a shot
+    uint64_t releaseEdge = _current.releaseEdge;
+    finishSample();
+    _active = true;
+    _current.path = PATH_MODE;
+    _current.sound = t - releaseEdge;
+    return;
+  }
+  if (path >= 0 && _current.sound < 0 && t >= _current.pressEdge) {
+    _current.path = path;
+    _current.sound = t - _current.pressEdge;
+  }
+}
+
+#if ENABLE_EASY_AUDIO_PCM == 1
+// the mixer reports a start from the main loop, date it back to the first sample,
+// this is late by up to a sample period
+static void onSoundStart(uint8_t voice, uint8_t track, uint16_t played) {
+  (void)voice;
+  onTrack(track, sim::now() - (played - 1) * 1000000ULL / easymixer::SAMPLE_RATE);
+}
+#endif
+
+static void onShow(const uint8_t* rgb, size_t count, uint64_t t) {
+  bool wasWhite = _stripWhite;
+  _stripWhite = count > 0;
+  for (size_t i = 0; i < count * 3; i++)
+    if (rgb[i] != 255) _stripWhite = false;
+  if (_active && _current.light == -1 && _stripWhite)
+    _current.light = t - _current.pressEdge;
+  if (_autoHold && _stripWhite && !wasWhite) _autoFlashes.push_back(t);
+}
+
+static void press(uint64_t at) {
+  sim::runUntil(at);
+  finishSample();
+  _active = true;
+  _current.pressEdge = sim::now();
+  if (_stripWhite) _current.light = -2;   // no visible flash
+  sim::setPin(TRIGGER_PIN, LOW);
+}
+
+static void release(uint64_t at) {
+  sim::runUntil(at);
+  _current.releaseEdge = sim::now();
+  sim::setPin(TRIGGER_PIN, HIGH);
+}
+
+static uint64_t percentile(std::vector<uint64_t>& v, double p) {
+  if (v.empty()) return 0;
+  std::sort(v.begin(), v.end());
+  size_t idx = (size_t)(p * (v.size() - 1) + 0.5);
+  return v[idx];
+}
+
+static void printRow(const char* name, std::vector<uint64_t>& v) {
+  if (v.empty()) {
+    printf("  %-12s %8s\n", name, "-");
+    return;
+  }
+  printf("  %-12s %8zu %9.2f %9.2f %9.2f\n", name, v.size(),
+         percentile(v, 0.50) / 1000.0, percentile(v, 0.99) / 1000.0, percentile(v, 1.0) / 1000.0);
+}
+
+// long presses until the mode is selected with a full clip, a mode change reloads.
+// Leaving a full auto mode needs an empty clip, or the long press fires.
+static bool selectMode(uint8_t mode) {
+  for (int i = 0; i < 20 && (selectedTriggerMode != mode || !ammoCounter.isFull()); i++) {
+    uint64_t at = sim::now() + 300000;
+    press(at);
+    release(at + 4000000);
+    sim::runUntil(sim::now() + 500000);
+    finishSample();
+  }
+  return selectedTriggerMode == mode && ammoCounter.isFull();
+}
+
+static void runAutoHolds(long holds) {
+  uint8_t mode = AMMO_MODE_COUNT;
+  for (uint8_t i = 0; i < AMMO_MODE_COUNT && mode == AMMO_MODE_COUNT; i++)
+    if (pgm_read_byte(&AMMO_MODES[i].shots) == 0) mode = i;
+  if (mode == AMMO_MODE_COUNT) {
+    printf("full auto: no full auto mode in AMMO_MODES\n");
+    return;
+  }
+  uint16_t rpm = pgm_read_word(&AMMO_MODES[mode].rpm);
+  if (!rpm) rpm = AMMO_AUTO_RPM;
+  uint8_t clip = pgm_read_byte(&AMMO_MODES[mode].clipSize);
+  uint64_t period = 60000000ULL / rpm;
+
+  std::vector<uint64_t> gaps, skew;
+  long shots = 0, tracks = 0, flashes = 0;
+  uint8_t overheats = heat.getOverheats();
+  for (long h = 0; h < holds; h++) {
+    if (!selectMode(mode)) {
+      printf("full auto: could not select mode %u\n", mode);
+      return;
+    }
+    int before = ammoCounter.getCount();
+    _autoTracks.clear();
+    _autoFlashes.clear();
+    _autoHold = true;
+    sim::runUntil(sim::now() + 150000 + rand() % 100000);
+    sim::setPin(TRIGGER_PIN, LOW);
+    // hold past the last shot, but not long enough for the theme
+    sim::runUntil(sim::now() + period * (clip + 2) * 3 / 2);
+    sim::setPin(TRIGGER_PIN, HIGH);
+    sim::runUntil(sim::now() + 300000);
+    _autoHold = false;
+
+    shots += before - ammoCounter.getCount();
+    tracks += _autoTracks.size();
+    flashes += _autoFlashes.size();
+    for (size_t i = 1; i < _autoTracks.size(); i++)
+      gaps.push_back(_autoTracks[i] - _autoTracks[i - 1]);
+    for (size_t i = 0; i < _autoTracks.size() && i < _autoFlashes.size(); i++) {
+      uint64_t a = _autoTracks[i], b = _autoFlashes[i];
+      skew.push_back(a > b ? a - b : b - a);
+    }
+  }
+  printf("full auto: %ld holds at %u rpm, %ld shots, %ld fire tracks, %ld flashes, %u overheats\n",
+         holds, rpm, shots, tracks, flashes, (uint8_t)(heat.getOverheats() - overheats));
+  printf("  %-12s %8s %9s %9s %9s\n", "(ms)", "samples", "p50", "p99", "max");
+  printf("  %-12s %8s %9.2f\n", "cold gap", "", period / 1000.0);
+  printRow("gap", gaps);
+  printRow("track-flash", skew);
+}
+
+static void usage(const char* name) {
+  printf("usage: %s [-n cycles] [-r seed] [-l loop us]\n", name);
+  printf("  -n  number of clip/reload cycles to run (default 50)\n");
+  printf("  -r  random seed for the trigger timing (default 1)\n");
+  printf("  -l  us charged per loop() pass on top of modelled calls (default %u)\n", sim::loopOverheadUs);
+}
+
+int main(int argc, char** argv) {
+  long cycles = 50;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg == "-n" && i + 1 < argc) cycles = atol(argv[++i]);
+    else if (arg == "-r" && i + 1 < argc) seed = atoi(argv[++i]);
+    else if (arg == "-l" && i + 1 < argc) sim::loopOverheadUs = atol(argv[++i]);
+    else {
+      usage(argv[0]);
+      return arg == "-h" ? 0 : 1;
+    }
+  }
+  srand(seed);
+
+  sim::reset();
+  sim::setTrackListener(onTrack);
+  sim::setShowListener(onShow);
+  sim::runSetup();
+#if ENABLE_EASY_AUDIO_PCM == 1
+  audio.setTrackStartCallback(onSoundStart);
+#endif
+  sim::runUntil(5000000);
+
+  // each cycle empties the clip, dry fires, then holds the trigger to change mode
+  for (long c = 0; c < cycles; c++) {
+    for (int shot = 0; shot < 12; shot++) {
+      uint64_t at = sim::now() + 150000 + rand() % 250000;
+      press(at);
+      release(at + 40000 + rand() % 60000);
+    }
+    uint64_t at = sim::now() + 300000 + rand() % 1000;
+    press(at);
+    release(at + 2500000 + rand() % 1000);
+    sim::runUntil(sim::now() + 500000);
+  }
+  sim::runUntil(sim::now() + 500000);
+  finishSample();
+
+  printf("trigger-to-sound latency (ms)\n");
+  printf("  %-12s %8s %9s %9s %9s\n", "path", "samples", "p50", "p99", "max");
+  for (int p = 0; p < PATH_COUNT; p++) printRow(PATH_NAMES[p], _sound[p]);
+  printf("trigger-to-light latency (ms)\n");
+  printf("  %-12s %8s %9s %9s %9s\n", "path", "samples", "p50", "p99", "max");
+  for (int p = 0; p < PATH_COUNT; p++) printRow(PATH_NAMES[p], _light[p]);
+  uint32_t tracks = sim::tracksPlayed();
+  printf("audio serial cpu: %.1f ms in %.0f s, %.0f us per track\n", sim::audioTxCpuUs() / 1000.0,
+         sim::now() / 1e6, tracks ? (double)sim::audioTxCpuUs() / tracks : 0.0);
+#if ENABLE_DEBUG == 1
+  printf("debug serial cpu: %.1f ms\n", sim::debugTxCpuUs() / 1000.0);
+#endif
+
+  runAutoHolds(cycles / 5 + 1);
+  return 0;
+}
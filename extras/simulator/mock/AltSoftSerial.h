@@ -0,0 +1,33 @@
+#ifndef sim_altsoftserial_h
+#define sim_altsoftserial_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for AltSoftSerial.
+ *
+ * Writes go into a 68 byte buffer and are sent by a timer interrupt, so each
+ * byte only charges the interrupt time to the virtual clock. Written bytes are
+ * handed to the emulated DF player.
+ */
+class AltSoftSerial : public Stream {
+public:
+  AltSoftSerial() {}
+
+  void begin(uint32_t baud);
+  void end() {}
+  bool overflow() { return false; }
+
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t b);
+  using Print::write;
+
+  operator bool() { return true; }
+
+private:
+  uint32_t _baud = 9600;
+};
+
+#endif
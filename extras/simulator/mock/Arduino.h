@@ -0,0 +1,175 @@
+#ifndef sim_arduino_h
+#define sim_arduino_h
+
+/**
+ * Host stand-in for the Arduino core.
+ *
+ * Only the parts of the core used by the blaster sketch are provided. Time is
+ * driven by the virtual clock in "sim.h", so millis(), micros() and delay()
+ * never touch the wall clock.
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x0
+#define OUTPUT         0x1
+#define INPUT_PULLUP   0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define DEC 10
+#define HEX 16
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr)   (*(void* const*)(addr))
+#define memcpy_P  memcpy
+#define strcmp_P  strcmp
+#define strncmp_P strncmp
+#define strncpy_P strncpy
+#define strlen_P  strlen
+
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+#define NOT_AN_INTERRUPT -1
+
+void noInterrupts(void);
+void interrupts(void);
+
+/**
+ * The AVR timer registers used by the PCM mixer. Timer1 compare match A is run
+ * on the virtual clock, and OCR2A is the PWM output, see sim.h.
+ */
+#define F_CPU 16000000UL
+#define _BV(bit) (1 << (bit))
+// weak, sim.cpp only runs the interrupts the sketch defines
+#define ISR(vector) extern "C" __attribute__((weak)) void vector(void)
+
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TCCR2A, TCCR2B, OCR2A;
+extern volatile uint16_t OCR1A;
+#define CS10   0
+#define WGM12  3
+#define OCIE1A 1
+#define CS20   0
+#define WGM20  0
+#define WGM21  1
+#define COM2A1 7
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class __FlashStringHelper;
+
+char* itoa(int value, char* str, int base);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+void attachInterrupt(int8_t interruptNum, void (*isr)(void), int mode);
+void detachInterrupt(int8_t interruptNum);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+/**
+ * Minimal Print with the overloads the sketch uses.
+ */
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+  }
+  size_t write(const char* str) {
+    if (str == NULL) return 0;
+    return write(reinterpret_cast<const uint8_t*>(str), strlen(str));
+  }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = DEC) {
+    if (base == DEC && n < 0) return print('-') + print((unsigned long)(-n), base);
+    return print((unsigned long)n, base);
+  }
+  size_t print(unsigned long n, int base = DEC) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%lu", n);
+    return write(buf);
+  }
+  size_t print(double n, int digits = 2) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+  }
+
+  size_t println(void) { return write("\r\n"); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <typename T> size_t println(T v, int base) { size_t n = print(v, base); return n + println(); }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+/**
+ * Debug serial port. Output is forwarded to the simulation sink, which
+ * echoes it to stdout when verbose output is enabled.
+ */
+class HardwareSerial : public Stream {
+public:
+  HardwareSerial(uint8_t port) : _port(port) {}
+  void begin(unsigned long baud) { _baud = baud; }
+  void end() {}
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t b);
+  using Print::write;
+  int availableForWrite();
+  operator bool() { return true; }
+  unsigned long baud() const { return _baud; }
+private:
+  uint8_t _port;
+  unsigned long _baud = 0;
+};
+
+extern HardwareSerial Serial;
+
+#endif
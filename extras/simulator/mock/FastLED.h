@@ -0,0 +1,146 @@
+#ifndef sim_fastled_h
+#define sim_fastled_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the parts of FastLED used by the sketch.
+ *
+ * Each strip pushed by FastLED.show() or CLEDController::showLeds() charges the
+ * WS2812 wire time (30us per pixel plus the latch) to the virtual clock, since
+ * the real call runs with interrupts disabled.
+ */
+typedef uint8_t fract8;
+
+struct CRGB {
+  union {
+    struct {
+      union { uint8_t r; uint8_t red; };
+      union { uint8_t g; uint8_t green; };
+      union { uint8_t b; uint8_t blue; };
+    };
+    uint8_t raw[3];
+  };
+
+  typedef enum {
+    Black  = 0x000000,
+    Blue   = 0x0000FF,
+    Green  = 0x008000,
+    Orange = 0xFFA500,
+    Purple = 0x800080,
+    Red    = 0xFF0000,
+    White  = 0xFFFFFF,
+    Yellow = 0xFFFF00
+  } HTMLColorCode;
+
+  CRGB() : r(0), g(0), b(0) {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+
+  uint8_t& operator[](uint8_t x) { return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+  explicit operator bool() const { return r || g || b; }
+
+  CRGB& nscale8(uint8_t scaledown);
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs) {
+  return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs) {
+  return !(lhs == rhs);
+}
+
+enum EOrder { RGB = 0012, GRB = 0102 };
+enum ESPIChipsets { WS2812 };
+
+inline uint8_t scale8(uint8_t i, fract8 scale) { return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8; }
+inline uint8_t scale8_video(uint8_t i, fract8 scale) { return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0); }
+inline uint8_t qadd8(uint8_t i, uint8_t j) { unsigned int t = i + j; return t > 255 ? 255 : t; }
+inline uint8_t qsub8(uint8_t i, uint8_t j) { int t = i - j; return t < 0 ? 0 : t; }
+inline uint8_t dim8_video(uint8_t x) { return scale8_video(x, x); }
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+  return b > a ? a + scale8(b - a, frac) : a - scale8(a - b, frac);
+}
+inline CRGB& CRGB::nscale8(uint8_t scaledown) {
+  r = scale8(r, scaledown); g = scale8(g, scaledown); b = scale8(b, scaledown);
+  return *this;
+}
+inline CRGB blend(const CRGB& p1, const CRGB& p2, fract8 amountOfP2) {
+  return CRGB(lerp8by8(p1.r, p2.r, amountOfP2), lerp8by8(p1.g, p2.g, amountOfP2), lerp8by8(p1.b, p2.b, amountOfP2));
+}
+
+void fill_solid(struct CRGB* leds, int numToFill, const struct CRGB& color);
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fadeBy);
+
+/** One strip on one pin, showLeds() pushes only this strip */
+class CLEDController {
+public:
+  void showLeds(uint8_t brightness = 255);
+  CRGB* leds() { return _data; }
+  int size() { return _count; }
+
+private:
+  friend class CFastLED;
+  uint8_t _pin = 0;
+  CRGB* _data = 0;
+  int _count = 0;
+};
+
+/** No power model on the host, the requested brightness is always allowed */
+inline uint8_t calculate_max_brightness_for_power_mW(uint8_t target_brightness, uint32_t max_power_mW) {
+  (void)max_power_mW;
+  return target_brightness;
+}
+
+class CFastLED {
+public:
+  template <ESPIChipsets CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER>
+  CLEDController& addLeds(struct CRGB* data, int nLedsOrOffset) { return addController(DATA_PIN, data, nLedsOrOffset); }
+
+  void setBrightness(uint8_t scale) { _brightness = scale; }
+  uint8_t getBrightness() { return _brightness; }
+  void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) { (void)volts; (void)milliamps; }
+  void clear(bool writeData = false);
+  void show();
+  int count() { return _controllers; }
+  int size();
+  CLEDController& operator[](int x) { return _list[x]; }
+
+private:
+  CLEDController& addController(uint8_t pin, CRGB* data, int count);
+  static const int MAX_CONTROLLERS = 8;
+  CLEDController _list[MAX_CONTROLLERS];
+  int _controllers = 0;
+  uint8_t _brightness = 255;
+};
+
+extern CFastLED FastLED;
+
+/**
+ * Same semantics as FastLED: the timer is a function-local static whose
+ * period is latched the first time the statement runs.
+ */
+class CEveryNMillis {
+public:
+  CEveryNMillis(uint32_t period) : _period(period), _prev(millis()) {}
+  bool ready() {
+    uint32_t now = millis();
+    if (now - _prev >= _period) {
+      _prev = now;
+      return true;
+    }
+    return false;
+  }
+  operator bool() { return ready(); }
+private:
+  uint32_t _period;
+  uint32_t _prev;
+};
+
+#define FASTLED_PASTE2(a, b) a##b
+#define FASTLED_PASTE(a, b) FASTLED_PASTE2(a, b)
+#define EVERY_N_MILLISECONDS(N) static CEveryNMillis FASTLED_PASTE(_perMillis, __LINE__)(N); if (FASTLED_PASTE(_perMillis, __LINE__))
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef sim_softwareserial_h
+#define sim_softwareserial_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for SoftwareSerial.
+ *
+ * Writes are blocking on the real part (interrupts are disabled for the whole
+ * frame of each byte), so every byte written charges 10 bit times to the
+ * virtual clock. Written bytes are handed to the emulated DF player.
+ */
+class SoftwareSerial : public Stream {
+public:
+  SoftwareSerial(uint8_t rxPin, uint8_t txPin, bool inverse = false)
+    : _rxPin(rxPin), _txPin(txPin) { (void)inverse; }
+
+  void begin(long baud);
+  void end() {}
+  bool listen() { return true; }
+  bool isListening() { return true; }
+  bool overflow() { return false; }
+
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t b);
+  using Print::write;
+
+  operator bool() { return true; }
+
+private:
+  uint8_t _rxPin;
+  uint8_t _txPin;
+  long _baud = 9600;
+};
+
+#endif
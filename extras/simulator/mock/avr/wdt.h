@@ -0,0 +1,36 @@
+#ifndef sim_avr_wdt_h
+#define sim_avr_wdt_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the AVR watchdog. The simulator keeps the time out and the
+ * last wdt_reset() on the virtual clock, see sim::watchdogExpired(). The WDT
+ * interrupt does not run on its own, and a time out does not reset the sketch.
+ */
+#define WDTO_15MS   0
+#define WDTO_30MS   1
+#define WDTO_60MS   2
+#define WDTO_120MS  3
+#define WDTO_250MS  4
+#define WDTO_500MS  5
+#define WDTO_1S     6
+#define WDTO_2S     7
+#define WDTO_4S     8
+#define WDTO_8S     9
+
+#define WDIE        6
+extern volatile uint8_t WDTCSR;
+
+// MCUSR reset flags
+#define PORF        0
+#define EXTRF       1
+#define BORF        2
+#define WDRF        3
+extern volatile uint8_t MCUSR;
+
+void wdt_enable(uint8_t timeout);
+void wdt_disable(void);
+void wdt_reset(void);
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef sim_ezbutton_h
+#define sim_ezbutton_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the ezButton library, following the same debounce
+ * algorithm: a level change is accepted once it has been stable for the
+ * debounce time, measured from the last time the raw level flickered.
+ */
+class ezButton {
+private:
+  int btnPin;
+  unsigned long debounceTime = 0;
+  int previousSteadyState;
+  int lastSteadyState;
+  int lastFlickerableState;
+  unsigned long lastDebounceTime = 0;
+
+public:
+  ezButton(int pin) : btnPin(pin) {
+    if (btnPin >= 0) pinMode(btnPin, INPUT_PULLUP);
+    previousSteadyState = btnPin >= 0 ? digitalRead(btnPin) : HIGH;
+    lastSteadyState = previousSteadyState;
+    lastFlickerableState = previousSteadyState;
+  }
+
+  void setDebounceTime(unsigned long time) { debounceTime = time; }
+  int getState(void) { return lastSteadyState; }
+  int getStateRaw(void) { return btnPin >= 0 ? digitalRead(btnPin) : HIGH; }
+  bool isPressed(void) { return previousSteadyState == HIGH && lastSteadyState == LOW; }
+  bool isReleased(void) { return previousSteadyState == LOW && lastSteadyState == HIGH; }
+
+  void loop(void) {
+    int currentState = getStateRaw();
+    unsigned long currentTime = millis();
+
+    if (currentState != lastFlickerableState) {
+      lastDebounceTime = currentTime;
+      lastFlickerableState = currentState;
+    }
+
+    if ((currentTime - lastDebounceTime) >= debounceTime) {
+      previousSteadyState = lastSteadyState;
+      lastSteadyState = currentState;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,610 @@
+/*
+ * Virtual clock, pins, serial ports and LED output for the host simulation.
+ */
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include <SoftwareSerial.h>
+#include <AltSoftSerial.h>
+#include <FastLED.h>
+#include <avr/wdt.h>
+#include "config.h"
+#include "sim.h"
+
+void setup(void);
+void loop(void);
+
+// defined by the sketch when the PCM mixer is enabled
+extern "C" void TIMER1_COMPA_vect(void) __attribute__((weak));
+
+volatile uint8_t TCCR1A = 0, TCCR1B = 0, TIMSK1 = 0, TCCR2A = 0, TCCR2B = 0, OCR2A = 0;
+volatile uint16_t OCR1A = 0;
+volatile uint8_t WDTCSR = 0;
+volatile uint8_t MCUSR = _BV(PORF);
+
+namespace sim {
+
+uint32_t loopOverheadUs = 40;
+uint32_t clockReadUs = 1;
+uint32_t timerIsrUs = 10;
+
+static uint64_t _now = 0;
+static bool _verbose = false;
+static int _pins[32];
+static void (*_isr[2])(void) = {0, 0};
+static int _isrMode[2] = {0, 0};
+static serial_listener _audioListener = 0;
+static serial_listener _debugListener = 0;
+static std::deque<uint8_t> _consoleRx;
+static show_listener _showListener = 0;
+static uint32_t _audioTxBytes = 0;
+static uint32_t _showCount = 0;
+static uint32_t _replyLatency = 2000;
+
+struct rxbyte { uint64_t at; uint8_t value; };
+static std::deque<rxbyte> _audioRx;
+static std::string _atLine;
+static std::string _miniFrame;
+static uint64_t _commandStart = 0;
+static track_listener _trackListener = 0;
+static uint32_t _tracksPlayed = 0;
+static uint32_t _trackLengthMs = 400;
+static uint16_t _track = 0;
+static uint64_t _trackEnd = 0;      // time the current track ends, 0 when idle
+static uint64_t _audioTxCpuUs = 0;  // cpu time spent writing to the audio port
+static uint64_t _uartIdleAt = 0;    // time the buffered port's last byte is on the wire
+static uint64_t _debugIdleAt = 0;   // time the debug port's last byte is on the wire
+static uint64_t _debugTxCpuUs = 0;  // cpu time spent writing to the debug port
+static uint32_t _commandLoss = 0;   // every nth command to the player is lost, 0 for none
+static uint32_t _commandCount = 0;
+static uint32_t _loseIn = 0;        // the nth command from now is lost, 0 for none
+static uint16_t _missingTrack = 0;  // track the Mini answers with "not found", 0 for none
+static uint32_t _wdtPeriod = 0;     // us, 0 while the watchdog is stopped
+static uint64_t _wdtFed = 0;        // time of the last wdt_reset()
+static uint32_t _wdtExpired = 0;
+
+static bool _interruptsOff = false;
+static bool _inTimer = false;
+static uint64_t _timer1Next = 0;    // cpu cycle of the next compare match, 0 when stopped
+static uint64_t _nextDue = 0;       // time the timer or the player may next need to run, 0 to check now
+static bool _capturePcm = false;
+static std::vector<uint8_t> _pcm;
+
+static const uint64_t CYCLES_PER_US = F_CPU / 1000000;
+
+static void runPlayer();
+
+// Timer1 compare match period in cpu cycles, 0 when the interrupt is off
+static uint64_t timer1Period() {
+  static const uint16_t prescale[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+  uint16_t p = prescale[TCCR1B & 7];
+  if (!p || !(TIMSK1 & _BV(OCIE1A)) || !TIMER1_COMPA_vect) return 0;
+  return (uint64_t)p * (OCR1A + 1);
+}
+
+// runs the compare matches that are due, late ones run as soon as interrupts are back on
+static void runTimers() {
+  if (_interruptsOff || _inTimer) return;
+  uint64_t period = timer1Period();
+  if (!period) {
+    _timer1Next = 0;
+    return;
+  }
+  if (!_timer1Next) _timer1Next = _now * CYCLES_PER_US + period;
+  _inTimer = true;
+  while (_timer1Next <= _now * CYCLES_PER_US) {
+    TIMER1_COMPA_vect();
+    if (_capturePcm) _pcm.push_back((uint8_t)OCR2A);
+    _timer1Next += period;
+    _now += timerIsrUs;
+  }
+  _inTimer = false;
+}
+
+// the earliest time runTimers() or runPlayer() has anything to do
+static uint64_t nextDue() {
+  uint64_t due = _trackEnd ? _trackEnd : UINT64_MAX;
+  if (TIMER1_COMPA_vect) {
+    // a stopped timer may be started at any time, so keep checking until it runs
+    if (!timer1Period() || !_timer1Next || _interruptsOff) return _now;
+    uint64_t timer = (_timer1Next + CYCLES_PER_US - 1) / CYCLES_PER_US;
+    if (timer < due) due = timer;
+  }
+  return due;
+}
+
+uint64_t now() { return _now; }
+void advance(uint64_t us) {
+  _now += us;
+  // most calls are clock reads with nothing due, skip the checks until something is
+  if (_now < _nextDue) return;
+  runTimers();
+  runPlayer();
+  _nextDue = nextDue();
+}
+
+void reset() {
+  _now = 0;
+  for (int i = 0; i < 32; i++) _pins[i] = HIGH;
+  _isr[0] = _isr[1] = 0;
+  _audioRx.clear();
+  _consoleRx.clear();
+  _atLine.clear();
+  _miniFrame.clear();
+  _audioTxBytes = 0;
+  _tracksPlayed = 0;
+  _track = 0;
+  _trackEnd = 0;
+  _commandCount = 0;
+  _loseIn = 0;
+  _audioTxCpuUs = 0;
+  _uartIdleAt = 0;
+  _debugIdleAt = 0;
+  _debugTxCpuUs = 0;
+  _showCount = 0;
+  _interruptsOff = false;
+  _timer1Next = 0;
+  _nextDue = 0;
+  TCCR1A = TCCR1B = TIMSK1 = TCCR2A = TCCR2B = OCR2A = 0;
+  OCR1A = 0;
+  _pcm.clear();
+  MCUSR = _BV(PORF);
+  WDTCSR = 0;
+  _wdtPeriod = 0;
+  _wdtFed = 0;
+  _wdtExpired = 0;
+}
+
+void setInterrupts(bool enabled) {
+  _interruptsOff = !enabled;
+  _nextDue = 0;
+  if (enabled) runTimers();
+}
+
+void capturePcm(bool enabled) { _capturePcm = enabled; }
+size_t pcmSamples() { return _pcm.size(); }
+
+static void put32(FILE* f, uint32_t v) { fwrite(&v, 4, 1, f); }
+static void put16(FILE* f, uint16_t v) { fwrite(&v, 2, 1, f); }
+
+bool writeWav(const char* path) {
+  uint64_t period = timer1Period();
+  uint32_t rate = period ? (uint32_t)(F_CPU / period) : 8000;
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  uint32_t size = (uint32_t)_pcm.size();
+  fwrite("RIFF", 1, 4, f);
+  put32(f, 36 + size);
+  fwrite("WAVEfmt ", 1, 8, f);
+  put32(f, 16);
+  put16(f, 1);        // PCM
+  put16(f, 1);        // mono
+  put32(f, rate);
+  put32(f, rate);     // bytes per second
+  put16(f, 1);        // block align
+  put16(f, 8);        // unsigned 8 bit, same as the PWM duty
+  fwrite("data", 1, 4, f);
+  put32(f, size);
+  fwrite(_pcm.data(), 1, size, f);
+  fclose(f);
+  return true;
+}
+
+void setPin(uint8_t pin, int level) {
+  if (pin >= 32 || _pins[pin] == level) return;
+  int previous = _pins[pin];
+  _pins[pin] = level;
+  int irq = digitalPinToInterrupt(pin);
+  if (irq >= 0 && _isr[irq]) {
+    int mode = _isrMode[irq];
+    if (mode == CHANGE || (mode == FALLING && previous == HIGH) || (mode == RISING && previous == LOW))
+      _isr[irq]();
+  }
+}
+
+int getPin(uint8_t pin) { return pin < 32 ? _pins[pin] : HIGH; }
+
+void setVerbose(bool verbose) { _verbose = verbose; }
+void setAudioTxListener(serial_listener listener) { _audioListener = listener; }
+void setShowListener(show_listener listener) { _showListener = listener; }
+uint32_t audioTxBytes() { return _audioTxBytes; }
+uint64_t audioTxCpuUs() { return _audioTxCpuUs; }
+uint64_t debugTxCpuUs() { return _debugTxCpuUs; }
+uint32_t showCount() { return _showCount; }
+void setPlayerReplyLatency(uint32_t us) { _replyLatency = us; }
+void setTrackListener(track_listener listener) { _trackListener = listener; }
+uint32_t tracksPlayed() { return _tracksPlayed; }
+void setTrackLength(uint32_t ms) { _trackLengthMs = ms; }
+void setCommandLoss(uint32_t every) { _commandLoss = every; }
+void loseCommand(uint32_t n) { _loseIn = n; }
+void setMissingTrack(uint16_t track) { _missingTrack = track; }
+
+// counts a time out that ran without a wdt_reset(), then starts the next one
+static void feedWatchdog(uint32_t period) {
+  if (_wdtPeriod && _now - _wdtFed >= _wdtPeriod) _wdtExpired++;
+  _wdtPeriod = period;
+  _wdtFed = _now;
+}
+
+static void startWatchdog(uint8_t timeout) { feedWatchdog(16000UL << timeout); }
+static void stopWatchdog() { feedWatchdog(0); }
+static void resetWatchdog() { feedWatchdog(_wdtPeriod); }
+bool watchdogRunning() { return _wdtPeriod != 0; }
+
+void afterWatchdogReset() {
+  MCUSR = _BV(WDRF);
+  _wdtPeriod = 0;
+  startWatchdog(WDTO_15MS);
+}
+
+uint32_t watchdogExpired() {
+  return _wdtExpired + (_wdtPeriod && _now - _wdtFed >= _wdtPeriod ? 1 : 0);
+}
+
+// the command never reaches the player, so there is no reply either
+static bool commandLost() {
+  if (_loseIn && --_loseIn == 0) return true;
+  return _commandLoss && ++_commandCount % _commandLoss == 0;
+}
+
+void audioRx(const uint8_t* data, size_t len, uint64_t delayUs) {
+  // keep replies in time order, without splitting one that is already queued
+  uint64_t at = _now + delayUs;
+  size_t pos = _audioRx.size();
+  while (pos > 0 && _audioRx[pos - 1].at > at) pos--;
+  for (size_t i = 0; i < len; i++) _audioRx.insert(_audioRx.begin() + pos + i, {at, data[i]});
+}
+
+static uint32_t trackLengthMs(uint16_t track) {
+  return track == AUDIO_TRACK_THEME ? 30000 : _trackLengthMs;
+}
+
+static void trackStarted(uint16_t track) {
+  _tracksPlayed++;
+  _track = track;
+  _trackEnd = _now + _replyLatency + trackLengthMs(track) * 1000ULL;
+  _nextDue = 0;
+#if AUDIO_BUSY_PIN > 0
+  _pins[AUDIO_BUSY_PIN] = LOW;
+#endif
+  if (_trackListener) _trackListener(track, _commandStart);
+}
+
+static void miniReply(uint8_t command, uint16_t param, uint64_t delayUs) {
+  uint8_t frame[10] = {0x7E, 0xFF, 0x06, command, 0x00, (uint8_t)(param >> 8), (uint8_t)param, 0, 0, 0xEF};
+  int16_t checksum = 0;
+  for (int i = 1; i < 7; i++) checksum -= frame[i];
+  frame[7] = (uint8_t)(checksum >> 8);
+  frame[8] = (uint8_t)checksum;
+  audioRx(frame, sizeof(frame), delayUs);
+}
+
+// the DF Mini sends "track finished" twice, the BUSY line goes back HIGH
+static void trackFinished() {
+  _trackEnd = 0;
+#if AUDIO_BUSY_PIN > 0
+  _pins[AUDIO_BUSY_PIN] = HIGH;
+#endif
+#if ENABLE_EASY_AUDIO_PRO == 0
+  miniReply(0x3D, _track, 0);
+  miniReply(0x3D, _track, 10000);
+#endif
+}
+
+static void runPlayer() {
+  if (_trackEnd && _now >= _trackEnd) trackFinished();
+}
+
+/**
+ * Emulated DF Mini: 10 byte frames from 0x7E to 0xEF (8 bytes on the variant).
+ * Commands with feedback requested are ACKed, a reset is answered with ONLINE.
+ */
+static void miniReceive(uint8_t b) {
+  if (_miniFrame.empty() && b != 0x7E) return;
+  _miniFrame.push_back((char)b);
+  if (b == 0xEF && (_miniFrame.size() == 10 || _miniFrame.size() == 8)) {
+    uint8_t command = (uint8_t)_miniFrame[3];
+    bool feedback = _miniFrame[4] == 1;
+    uint16_t param = ((uint8_t)_miniFrame[5] << 8) | (uint8_t)_miniFrame[6];
+    _miniFrame.clear();
+    if (commandLost()) return;
+    if (command == 0x12 && param == _missingTrack) {
+      // not found, and no "track finished" later. The listener still sees the play
+      miniReply(0x40, 0x06, _replyLatency);
+      if (_trackListener) _trackListener(param, _commandStart);
+      return;
+    }
+    if (command == 0x12) trackStarted(param);
+    if (command == 0x0C) miniReply(0x3F, 0x02, 500000);
+    else if (feedback) miniReply(0x41, 0, _replyLatency);
+  } else if (_miniFrame.size() >= 10) {
+    _miniFrame.clear();
+  }
+}
+
+/**
+ * Emulated DF Pro: AT command lines are answered with "OK\r\n", the length
+ * query with the track length in seconds.
+ */
+static void proReceive(uint8_t b) {
+  if (_atLine.empty() && b != 'A') return;
+  _atLine.push_back((char)b);
+  if (_atLine.size() >= 2 && _atLine.compare(_atLine.size() - 2, 2, "\r\n") == 0) {
+    if (commandLost()) {
+      _atLine.clear();
+      return;
+    }
+    if (_atLine.compare(0, 11, "AT+PLAYNUM=") == 0) trackStarted(atoi(_atLine.c_str() + 11));
+    if (_atLine.compare(0, 10, "AT+QUERY=4") == 0) {
+      char reply[16];
+      int len = snprintf(reply, sizeof(reply), "%u\r\n", (unsigned)((trackLengthMs(_track) + 500) / 1000));
+      audioRx((const uint8_t*)reply, len, _replyLatency);
+    } else {
+      static const uint8_t ok[] = {'O', 'K', '\r', '\n'};
+      audioRx(ok, sizeof(ok), _replyLatency);
+    }
+    _atLine.clear();
+  } else if (_atLine.size() > 64) {
+    _atLine.clear();
+  }
+}
+
+static void playerReceive(uint8_t b) {
+  if (_miniFrame.empty() && _atLine.empty()) _commandStart = _now;
+#if ENABLE_EASY_AUDIO_PRO == 1
+  proReceive(b);
+#else
+  miniReceive(b);
+#endif
+}
+
+static void audioTx(uint8_t b) {
+  _audioTxBytes++;
+  if (_audioListener) _audioListener(b, _now);
+  playerReceive(b);
+}
+
+static int audioAvailable() {
+  int n = 0;
+  for (size_t i = 0; i < _audioRx.size() && _audioRx[i].at <= _now; i++) n++;
+  return n;
+}
+
+static int audioRead() {
+  if (_audioRx.empty() || _audioRx.front().at > _now) return -1;
+  int b = _audioRx.front().value;
+  _audioRx.pop_front();
+  return b;
+}
+
+static int audioPeek() {
+  if (_audioRx.empty() || _audioRx.front().at > _now) return -1;
+  return _audioRx.front().value;
+}
+
+static int consoleAvailable() { return (int)_consoleRx.size(); }
+
+static int consoleRead() {
+  if (_consoleRx.empty()) return -1;
+  int b = _consoleRx.front();
+  _consoleRx.pop_front();
+  return b;
+}
+
+static int consolePeek() { return _consoleRx.empty() ? -1 : _consoleRx.front(); }
+
+// blocking port, the cpu is busy for the whole byte
+static void blockingWrite(uint8_t b, uint32_t baud) {
+  audioTx(b);
+  uint64_t us = 10000000ULL / baud;
+  _audioTxCpuUs += us;
+  advance(us);
+}
+
+// bytes still in the buffer of the buffered port
+static uint32_t uartQueued(uint32_t baud) {
+  if (_uartIdleAt <= _now) return 0;
+  uint64_t byteUs = 10000000ULL / baud;
+  return (uint32_t)((_uartIdleAt - _now + byteUs - 1) / byteUs);
+}
+
+// buffered port, the byte is copied to the buffer and sent by an interrupt
+static void bufferedWrite(uint8_t b, uint32_t baud, uint32_t cpuUs, uint32_t size) {
+  uint64_t byteUs = 10000000ULL / baud;
+  uint32_t queued = uartQueued(baud);
+  // a full buffer blocks until a byte has gone out
+  if (queued >= size) {
+    uint64_t wait = _uartIdleAt - _now - (size - 1) * byteUs;
+    _audioTxCpuUs += wait;
+    advance(wait);
+  }
+  audioTx(b);
+  _uartIdleAt = (_uartIdleAt > _now ? _uartIdleAt : _now) + byteUs;
+  _audioTxCpuUs += cpuUs;
+  advance(cpuUs);
+}
+
+static void debugTx(uint8_t b) {
+  if (_verbose && b != '\r') fputc(b, stdout);
+  if (_debugListener) _debugListener(b, _now);
+}
+
+// bytes still in the buffer of the debug port
+static uint32_t debugQueued(uint32_t baud) {
+  if (_debugIdleAt <= _now || !baud) return 0;
+  uint64_t byteUs = 10000000ULL / baud;
+  return (uint32_t)((_debugIdleAt - _now + byteUs - 1) / byteUs);
+}
+
+// the hardware UART as the debug port, like bufferedWrite() without touching the audio port
+static void debugWrite(uint8_t b, uint32_t baud) {
+  if (!baud) return;   // not begun
+  uint64_t byteUs = 10000000ULL / baud;
+  if (debugQueued(baud) >= 63) {
+    uint64_t wait = _debugIdleAt - _now - 62 * byteUs;
+    _debugTxCpuUs += wait;
+    advance(wait);
+  }
+  debugTx(b);
+  _debugIdleAt = (_debugIdleAt > _now ? _debugIdleAt : _now) + byteUs;
+  _debugTxCpuUs += 5;
+  advance(5);
+}
+
+void consoleRx(const char* text) {
+  while (*text) _consoleRx.push_back((uint8_t)*text++);
+}
+
+void setDebugListener(serial_listener listener) { _debugListener = listener; }
+
+static void ledShow(const CRGB* data, int count) {
+  _showCount++;
+  if (_showListener) _showListener(&data[0].r, count, _now);
+  // WS2812 wire time: 30us per pixel plus the 50us latch, interrupts off
+  _now += 30 * (uint64_t)count + 50;
+}
+
+void runSetup() {
+  ::setup();
+}
+
+void runUntil(uint64_t deadlineUs) {
+  while (_now < deadlineUs) {
+    ::loop();
+    advance(loopOverheadUs);
+  }
+}
+
+}  // namespace sim
+
+/**
+ * Arduino core
+ */
+HardwareSerial Serial(0);
+
+unsigned long millis(void) {
+  sim::advance(sim::clockReadUs);
+  return (unsigned long)(sim::now() / 1000);
+}
+
+unsigned long micros(void) {
+  sim::advance(sim::clockReadUs);
+  return (unsigned long)sim::now();
+}
+
+void noInterrupts(void) { sim::setInterrupts(false); }
+void interrupts(void) { sim::setInterrupts(true); }
+
+void delay(unsigned long ms) { sim::advance((uint64_t)ms * 1000); }
+void delayMicroseconds(unsigned int us) { sim::advance(us); }
+
+void wdt_enable(uint8_t timeout) { sim::startWatchdog(timeout); }
+void wdt_disable(void) { sim::stopWatchdog(); }
+void wdt_reset(void) { sim::resetWatchdog(); }
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+int digitalRead(uint8_t pin) { return sim::getPin(pin); }
+void digitalWrite(uint8_t pin, uint8_t val) { sim::setPin(pin, val); }
+
+void attachInterrupt(int8_t interruptNum, void (*isr)(void), int mode) {
+  if (interruptNum < 0 || interruptNum > 1) return;
+  sim::_isr[interruptNum] = isr;
+  sim::_isrMode[interruptNum] = mode;
+}
+
+void detachInterrupt(int8_t interruptNum) {
+  if (interruptNum < 0 || interruptNum > 1) return;
+  sim::_isr[interruptNum] = 0;
+}
+
+long random(long howbig) { return howbig ? rand() % howbig : 0; }
+long random(long howsmall, long howbig) { return howsmall + random(howbig - howsmall); }
+
+char* itoa(int value, char* str, int base) {
+  if (base == 16) sprintf(str, "%x", value);
+  else sprintf(str, "%d", value);
+  return str;
+}
+
+#if AUDIO_SERIAL == AUDIO_SERIAL_HARDWARE
+// the DF player is on the hardware UART, there is no debug output
+int HardwareSerial::available() { return sim::audioAvailable(); }
+int HardwareSerial::read() { return sim::audioRead(); }
+int HardwareSerial::peek() { return sim::audioPeek(); }
+int HardwareSerial::availableForWrite() { return 63 - sim::uartQueued(_baud); }
+size_t HardwareSerial::write(uint8_t b) {
+  // a few us to fill the buffer plus the data register empty interrupt
+  sim::bufferedWrite(b, _baud, 5, 63);
+  return 1;
+}
+#else
+int HardwareSerial::available() { return sim::consoleAvailable(); }
+int HardwareSerial::read() { return sim::consoleRead(); }
+int HardwareSerial::peek() { return sim::consolePeek(); }
+int HardwareSerial::availableForWrite() { return 63 - sim::debugQueued(_baud); }
+size_t HardwareSerial::write(uint8_t b) {
+  // a full buffer blocks until a byte has gone out, as it does for the player
+  sim::debugWrite(b, _baud);
+  return 1;
+}
+#endif
+
+void SoftwareSerial::begin(long baud) { _baud = baud; }
+int SoftwareSerial::available() { return sim::audioAvailable(); }
+int SoftwareSerial::read() { return sim::audioRead(); }
+int SoftwareSerial::peek() { return sim::audioPeek(); }
+size_t SoftwareSerial::write(uint8_t b) {
+  // start bit, 8 data bits and a stop bit with interrupts disabled
+  sim::blockingWrite(b, _baud);
+  return 1;
+}
+
+void AltSoftSerial::begin(uint32_t baud) { _baud = baud; }
+int AltSoftSerial::available() { return sim::audioAvailable(); }
+int AltSoftSerial::read() { return sim::audioRead(); }
+int AltSoftSerial::peek() { return sim::audioPeek(); }
+size_t AltSoftSerial::write(uint8_t b) {
+  // a timer compare interrupt for each change of level, about 15us a byte
+  sim::bufferedWrite(b, _baud, 15, 68);
+  return 1;
+}
+
+/**
+ * FastLED
+ */
+CFastLED FastLED;
+
+void fill_solid(struct CRGB* leds, int numToFill, const struct CRGB& color) {
+  for (int i = 0; i < numToFill; i++) leds[i] = color;
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fadeBy) {
+  for (uint16_t i = 0; i < num_leds; i++) leds[i].nscale8(255 - fadeBy);
+}
+
+void CLEDController::showLeds(uint8_t brightness) {
+  (void)brightness;
+  if (_data) sim::ledShow(_data, _count);
+}
+
+CLEDController& CFastLED::addController(uint8_t pin, CRGB* data, int count) {
+  // the host keeps a fixed number of strips, extra ones replace the last
+  CLEDController& c = _list[_controllers < MAX_CONTROLLERS ? _controllers++ : MAX_CONTROLLERS - 1];
+  c._pin = pin;
+  c._data = data;
+  c._count = count;
+  return c;
+}
+
+void CFastLED::clear(bool writeData) {
+  for (int i = 0; i < _controllers; i++) fill_solid(_list[i].leds(), _list[i].size(), CRGB::Black);
+  if (writeData) show();
+}
+
+void CFastLED::show() {
+  for (int i = 0; i < _controllers; i++) _list[i].showLeds(_brightness);
+}
+
+int CFastLED::size() { return _controllers ? _list[0].size() : 0; }
@@ -0,0 +1,124 @@
+#ifndef sim_h
+#define sim_h
+
+/**
+ * Control surface for the host simulation.
+ *
+ * The sketch never sees these functions; they are used by the simulator and
+ * benchmark drivers to move the virtual clock, drive input pins and observe
+ * what the sketch pushes out to the audio player and the LEDs.
+ *
+ * All times are in virtual microseconds since power on.
+ */
+#include <stdint.h>
+#include <stddef.h>
+
+namespace sim {
+
+/** Virtual clock */
+uint64_t now();
+void advance(uint64_t us);
+void reset();
+
+/** Cost model, in microseconds, charged against the virtual clock */
+extern uint32_t loopOverheadUs;   // per loop() call, outside of modelled calls
+extern uint32_t clockReadUs;      // per millis()/micros() call
+extern uint32_t timerIsrUs;       // per Timer1 compare match interrupt (PCM mixer)
+
+/** Input pins, levels follow digitalRead() (LOW when a pulled-up trigger is pressed) */
+void setPin(uint8_t pin, int level);
+int getPin(uint8_t pin);
+
+/** Echo debug Serial output to stdout */
+void setVerbose(bool verbose);
+
+/**
+ * The debug console. Queue text for the sketch to read from Serial, and
+ * observe what it writes. Both are unused when the player is on the hardware UART.
+ */
+void consoleRx(const char* text);
+
+/**
+ * Observers for the outputs of the sketch. Each is called with the virtual
+ * time at which the event happened.
+ */
+typedef void (*serial_listener)(uint8_t b, uint64_t t);
+typedef void (*show_listener)(const uint8_t* rgb, size_t count, uint64_t t);
+typedef void (*track_listener)(uint16_t track, uint64_t t);
+void setAudioTxListener(serial_listener listener);
+void setShowListener(show_listener listener);
+void setDebugListener(serial_listener listener);
+
+/** Called with the track number and the time the first byte of the play command was sent */
+void setTrackListener(track_listener listener);
+uint32_t tracksPlayed();
+
+/** Number of bytes written to the audio port and number of FastLED.show() calls */
+uint32_t audioTxBytes();
+
+/**
+ * CPU time spent writing to the audio port. SoftwareSerial is charged the
+ * whole byte time, the buffered ports (hardware UART, AltSoftSerial) only the
+ * interrupt time, unless the buffer is full.
+ */
+uint64_t audioTxCpuUs();
+
+/** CPU time spent writing to the debug port, blocked while its buffer is full */
+uint64_t debugTxCpuUs();
+uint32_t showCount();
+
+/**
+ * Emulated DF player on the other end of the audio serial port. Builds with
+ * ENABLE_EASY_AUDIO_PRO=1 get a DF Pro that answers AT commands with "OK\r\n"
+ * after the reply latency, all other builds get a DF Mini.
+ *
+ * The Mini ACKs commands sent with feedback requested.
+ * Each track plays for the track length, 400ms by default, the theme for 30s.
+ * At the end the Mini sends its "track finished" frame twice, and the BUSY
+ * line on AUDIO_BUSY_PIN goes back HIGH. The Pro answers the length query
+ * with the length in whole seconds.
+ */
+void setPlayerReplyLatency(uint32_t us);
+void setTrackLength(uint32_t ms);
+
+/** Lose every nth command sent to the player, 0 to lose none */
+void setCommandLoss(uint32_t every);
+
+/** Lose the nth command the player receives from now, 1 for the next one */
+void loseCommand(uint32_t n);
+
+/** The Mini answers a play of the track with a "not found" error, 0 for none */
+void setMissingTrack(uint16_t track);
+
+/**
+ * The AVR watchdog of ENABLE_EASY_WATCHDOG builds, run by wdt_enable(), wdt_reset()
+ * and wdt_disable(). afterWatchdogReset() leaves it as a watchdog reset does before
+ * setup: running at 15ms, with WDRF set in MCUSR. watchdogExpired() counts the time
+ * outs that ran without a wdt_reset(), on the Nano each is an interrupt or a reset.
+ */
+void afterWatchdogReset();
+bool watchdogRunning();
+uint32_t watchdogExpired();
+
+/** Queue bytes for the sketch to receive on the audio port */
+void audioRx(const uint8_t* data, size_t len, uint64_t delayUs = 0);
+
+/**
+ * Timer1 compare match A runs on the virtual clock when the sketch enables it,
+ * as the PCM mixer does. Interrupts that fall due while noInterrupts() is in
+ * effect, or while FastLED writes the leds, run late.
+ * While captured, the PWM duty (OCR2A) is recorded after every interrupt and
+ * can be saved as an 8 bit mono WAV at the interrupt rate.
+ */
+void setInterrupts(bool enabled);
+void capturePcm(bool enabled);
+size_t pcmSamples();
+bool writeWav(const char* path);
+
+/** Run the sketch: setup() once, then loop() until the virtual clock reaches the deadline */
+void runSetup();
+void runUntil(uint64_t deadlineUs);
+
+}
+
+#endif
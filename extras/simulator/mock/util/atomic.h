@@ -0,0 +1,17 @@
+#ifndef sim_util_atomic_h
+#define sim_util_atomic_h
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the avr-libc atomic blocks. The block runs with the Timer1
+ * interrupt held off, as noInterrupts() does. Both kinds turn interrupts back on
+ * at the end, the sketch only uses them with interrupts on.
+ */
+#define ATOMIC_RESTORESTATE 1
+#define ATOMIC_FORCEON      1
+
+#define ATOMIC_BLOCK(type) \
+  for (uint8_t _atomicDone = (noInterrupts(), 0); !_atomicDone; interrupts(), _atomicDone = 1)
+
+#endif
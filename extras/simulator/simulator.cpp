@@ -0,0 +1,410 @@
+/*
+ * name:  simulator.cpp
+ * Description: Replays scripted trigger presses through the blaster sketch
+ *              on a virtual clock.
+ *
+ * Script format, one action per line, times in ms from the start of the script:
+ *   # comment
+ *   500  press
+ *   650  release
+ *   800  dump       send 't' on the debug console, the sketch dumps its trace
+ *   900  lose 2     the 2nd command the player receives from now is lost
+ *   900  missing 8  the Mini answers a play of track 8 with "not found"
+ *   950  expect 8 2 the run fails unless track 8 has played 2 times in this run
+ *   9000 end
+ *
+ * A trace dump, from a blaster or from -d, can be replayed with -r. The trigger
+ * edges in the dump are replayed at the same ms since power on, and the records
+ * the sketch makes are compared with the dump, see easytrace.h. When the dump
+ * no longer holds the boot record, the replay starts at the first trigger pull
+ * in the dump instead. The ammo mode and the barrel heat are set from the state
+ * record of the pull, and the shots left from the first shot after it. The
+ * records before the pull belong to earlier pulls, and are not compared.
+ */
+#include <vector>
+#include <string>
+#include <chrono>
+
+#include "sim.h"
+#include <Arduino.h>
+#include "config.h"
+#include "easytrace.h"
+#include "easycounter.h"
+#include "easyheat.h"
+#if ENABLE_EASY_AUDIO_PCM == 1
+#include "easyaudio.h"
+extern EasyAudio audio;
+#endif
+
+struct action {
+  uint64_t at;     // ms from the start of the script
+  int level;       // pin level, or one of the ACTION_ values
+  unsigned track;  // of missing and expect
+  unsigned count;  // of lose and expect
+};
+static const int ACTION_END = -1;
+static const int ACTION_DUMP = -2;
+static const int ACTION_LOSE = -3;
+static const int ACTION_MISSING = -4;
+static const int ACTION_EXPECT = -5;
+
+// a trace record with the full time in ms since power on
+struct traceEvent {
+  uint32_t ms;
+  uint8_t type;
+  uint8_t param;
+  uint16_t value;  // the heat of a state record
+};
+static const char* TRACE_NAMES[] = {"epoch", "boot", "button", "shot", "dry", "audio", "led", "mode", "heat", "state"};
+
+extern EasyTrace<TRACE_EVENTS> trace;
+extern EasyCounter ammoCounter;
+extern EasyHeat heat;
+extern bool ventPlayed;
+extern void loadAmmoMode(uint8_t mode);
+static std::string _line;          // debug output line being received
+static std::string _block;         // lines of the dump being received
+static std::string _lastDump;
+static std::string _lastProfile;
+static std::string _lastLoop;
+
+static bool _logTracks = false;
+static uint32_t _soundsStarted = 0;
+static uint32_t _trackCounts[256];  // plays of each track in this run of the script
+static uint32_t _expectFailed = 0;
+
+static void onTrack(uint16_t track, uint64_t t) {
+  if (_logTracks) printf("%10.3f ms  track %u\n", t / 1000.0, track);
+  _trackCounts[track & 0xFF]++;
+}
+
+#if ENABLE_EASY_AUDIO_PCM == 1
+// the mixer reports a start from the main loop, date it back to the first sample
+static void onSoundStart(uint8_t voice, uint8_t track, uint16_t played) {
+  (void)voice;
+  _soundsStarted++;
+  onTrack(track, sim::now() - (played - 1) * 1000000ULL / easymixer::SAMPLE_RATE);
+}
+#endif
+
+static bool loadScript(const char* path, std::vector<action>& script) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  char line[128];
+  int lineNo = 0;
+  while (fgets(line, sizeof(line), f)) {
+    lineNo++;
+    unsigned long long at;
+    char verb[32];
+    unsigned a = 0, b = 0;
+    if (line[0] == '#' || sscanf(line, "%llu %31s %u %u", &at, verb, &a, &b) < 2) continue;
+    std::string v(verb);
+    if (v == "press") script.push_back({at, LOW, 0, 0});
+    else if (v == "release") script.push_back({at, HIGH, 0, 0});
+    else if (v == "end") script.push_back({at, ACTION_END, 0, 0});
+    else if (v == "dump") script.push_back({at, ACTION_DUMP, 0, 0});
+    else if (v == "lose") script.push_back({at, ACTION_LOSE, 0, a});
+    else if (v == "missing") script.push_back({at, ACTION_MISSING, a, 0});
+    else if (v == "expect") script.push_back({at, ACTION_EXPECT, a, b});
+    else fprintf(stderr, "%s:%d: unknown action '%s'\n", path, lineNo, verb);
+  }
+  fclose(f);
+  return true;
+}
+
+// keeps the last trace dump, profile and loop times, each from its first line to END
+static void onDebug(uint8_t b, uint64_t t) {
+  (void)t;
+  if (b == '\r') return;
+  if (b != '\n') {
+    _line += (char)b;
+    return;
+  }
+  if (_line.compare(0, 6, "TRACE ") == 0 || _line.compare(0, 8, "PROFILE ") == 0 ||
+      _line.compare(0, 5, "LOOP ") == 0) {
+    _block = _line + "\n";
+  } else if (!_block.empty()) {
+    _block += _line + "\n";
+    if (_line == "END") {
+      (_block[0] == 'T' ? _lastDump : (_block[0] == 'P' ? _lastProfile : _lastLoop)) = _block;
+      _block.clear();
+    }
+  }
+  _line.clear();
+}
+
+// adds the records the sketch made since the last call, with their full time
+static void drainTrace(std::vector<traceEvent>& out) {
+  static uint16_t seen = 0;
+  static uint32_t epoch = 0;
+  static uint32_t last = 0;   // ms of the last record, a state record takes it
+  uint16_t fresh = trace.getTotal() - seen;
+  if (fresh > trace.size()) {
+    fprintf(stderr, "%u trace records lost, drain more often\n", fresh - trace.size());
+    fresh = trace.size();
+  }
+  EasyTraceRecord r;
+  for (uint8_t i = trace.size() - fresh; trace.get(i, r); i++) {
+    if (r.type == easytrace::EPOCH) epoch = r.time;
+    else if (r.type == easytrace::STATE) out.push_back({last, r.type, r.param, r.time});
+    else out.push_back({last = (epoch << 16) | r.time, r.type, r.param, 0});
+  }
+  seen = trace.getTotal();
+}
+
+static bool loadDump(const char* path, std::vector<traceEvent>& events) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", path);
+    return false;
+  }
+  char line[128];
+  bool inDump = false;
+  uint32_t epoch = 0;
+  uint32_t last = 0;
+  while (fgets(line, sizeof(line), f)) {
+    unsigned long now, base, count, time, type, param;
+    if (sscanf(line, "TRACE %lu %lu %lu", &now, &base, &count) == 3) {
+      inDump = true;
+      epoch = base;
+      events.clear();   // the last dump in the file wins
+    } else if (inDump && strncmp(line, "END", 3) == 0) {
+      inDump = false;
+    } else if (inDump && sscanf(line, "%lu %lu %lu", &time, &type, &param) == 3) {
+      if (type == easytrace::EPOCH) epoch = time;
+      else if (type == easytrace::STATE) {
+        // the pull of a state record at the start of the ring has been written over
+        if (!events.empty()) events.push_back({last, (uint8_t)type, (uint8_t)param, (uint16_t)time});
+      }
+      else events.push_back({last = (epoch << 16) | (uint32_t)time, (uint8_t)type, (uint8_t)param, 0});
+    }
+  }
+  fclose(f);
+  if (events.empty()) fprintf(stderr, "%s: no trace dump found\n", path);
+  return !events.empty();
+}
+
+static void printEvent(const char* who, const traceEvent& e) {
+  const char* name = e.type < sizeof(TRACE_NAMES) / sizeof(TRACE_NAMES[0]) ? TRACE_NAMES[e.type] : "?";
+  if (e.type == easytrace::STATE) printf("  %-8s %8u ms  %-6s %u heat %u\n", who, e.ms, name, e.param, e.value);
+  else printf("  %-8s %8u ms  %-6s %u\n", who, e.ms, name, e.param);
+}
+
+// runs the sketch to the time, a few ms at a time so the trace ring does not wrap
+static void replayUntil(uint64_t at, std::vector<traceEvent>& replayed) {
+  for (; sim::now() < at; drainTrace(replayed))
+    sim::runUntil(at < sim::now() + 10000 ? at : sim::now() + 10000);
+}
+
+/**
+ * Sets the blaster to the state of a pull from the dump: the ammo mode and the
+ * heat from its state record, and the shots left from the first shot after it.
+ */
+static void seedState(const std::vector<traceEvent>& recorded, size_t pull) {
+  const traceEvent& state = recorded[pull + 1];
+  uint8_t mode = state.param & 0x7F;
+  loadAmmoMode(mode);
+  heat.setHeat(state.value, state.param & 0x80);
+  ventPlayed = state.param & 0x80;
+  int left = -1;
+  for (size_t i = pull; i < recorded.size() && left < 0; i++) {
+    if (recorded[i].type == easytrace::SHOT) left = recorded[i].param + 1;
+    else if (recorded[i].type == easytrace::DRY) left = 0;
+    else if (recorded[i].type == easytrace::MODE) break;   // reloads before any shot
+  }
+  while (left >= 0 && ammoCounter.getCount() > left && ammoCounter.tick());
+  printf("replay: ammo mode %u, heat %u%s, %s shots left\n", mode, state.value,
+         state.param & 0x80 ? " (overheated)" : "", left < 0 ? "a full clip of" : std::to_string(left).c_str());
+}
+
+/**
+ * Replays the trigger edges of a dump from power on, or from its first pull,
+ * then compares the records. Returns the number of records that differ.
+ */
+static int replayDump(std::vector<traceEvent> recorded) {
+  printf("replay: %zu records from %u ms to %u ms\n", recorded.size(), recorded.front().ms, recorded.back().ms);
+
+  std::vector<traceEvent> replayed;
+  size_t dropped = 0;
+  sim::runSetup();
+  if (recorded.front().type != easytrace::BOOT) {
+    size_t p = 0;
+    while (p + 1 < recorded.size() && recorded[p + 1].type != easytrace::STATE) p++;
+    if (p + 1 >= recorded.size()) {
+      printf("replay: the dump starts after boot and has no trigger pull to start from\n");
+      return (int)recorded.size();
+    }
+    printf("replay: the dump starts after boot, replaying from the pull at %u ms\n", recorded[p].ms);
+    dropped = p;
+    replayUntil(recorded[p].ms * 1000ULL, replayed);
+    seedState(recorded, p);
+    recorded.erase(recorded.begin(), recorded.begin() + p);
+    drainTrace(replayed);
+  }
+  uint32_t first = recorded.front().ms;
+  uint32_t last = recorded.back().ms;
+  replayed.clear();
+
+  for (size_t i = 0; i < recorded.size(); i++) {
+    if (recorded[i].type != easytrace::BUTTON) continue;
+    replayUntil(recorded[i].ms * 1000ULL, replayed);
+    sim::setPin(TRIGGER_PIN, recorded[i].param ? LOW : HIGH);
+  }
+  replayUntil((last + 1000) * 1000ULL, replayed);
+
+  // compare the records in the window of the dump, in order
+  std::vector<traceEvent> window;
+  for (size_t i = 0; i < replayed.size(); i++)
+    if (replayed[i].ms >= first && replayed[i].ms <= last) window.push_back(replayed[i]);
+  size_t n = window.size() < recorded.size() ? window.size() : recorded.size();
+  uint32_t worst = 0;
+  for (size_t i = 0; i < n; i++) {
+    const traceEvent& a = recorded[i];
+    const traceEvent& b = window[i];
+    if (a.type != b.type || a.param != b.param) {
+      printf("replay: differs at record %zu of %zu\n", i, recorded.size());
+      for (size_t j = (i > 3 ? i - 3 : 0); j <= i + 3 && j < n; j++) {
+        printEvent("dump", recorded[j]);
+        printEvent("replay", window[j]);
+      }
+      return (int)(recorded.size() - i);
+    }
+    uint32_t diff = a.ms > b.ms ? a.ms - b.ms : b.ms - a.ms;
+    if (diff > worst) worst = diff;
+  }
+  if (window.size() != recorded.size()) {
+    printf("replay: %zu records in the dump, %zu in the replay\n", recorded.size(), window.size());
+    return 1;
+  }
+  if (dropped)
+    printf("replay: all %zu records from the first pull match, largest time difference %u ms, %zu records before it not compared\n", n, worst, dropped);
+  else
+    printf("replay: all %zu records match, largest time difference %u ms\n", n, worst);
+  return 0;
+}
+
+static void usage(const char* name) {
+  printf("usage: %s [-s script] [-n repeats] [-b boot ms] [-l loop us] [-w wav] [-c n] [-d file] [-r file] [-p] [-t] [-v]\n", name);
+  printf("  -s  script of trigger presses to replay\n");
+  printf("  -n  number of times to replay the script (default 1)\n");
+  printf("  -b  ms to run after setup before the script starts (default 3000)\n");
+  printf("  -l  us charged per loop() pass on top of modelled calls (default %u)\n", sim::loopOverheadUs);
+  printf("  -w  save the PCM mixer output as a WAV file (PCM builds only)\n");
+  printf("  -c  lose every nth command sent to the DF player\n");
+  printf("  -d  save the last trace dump of the script to a file\n");
+  printf("  -r  replay a trace dump and compare the trace of the replay with it\n");
+  printf("  -p  print the execution time probes (ENABLE_EASY_PROFILE=1) and the loop times of the\n");
+  printf("      script runs\n");
+  printf("  -t  print each track as the play command is sent\n");
+  printf("  -v  echo the sketch's debug Serial output\n");
+}
+
+int main(int argc, char** argv) {
+  const char* scriptPath = NULL;
+  const char* wavPath = NULL;
+  const char* dumpPath = NULL;
+  const char* replayPath = NULL;
+  bool profile = false;
+  long repeats = 1;
+  uint64_t bootMs = 3000;
+
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg == "-s" && i + 1 < argc) scriptPath = argv[++i];
+    else if (arg == "-n" && i + 1 < argc) repeats = atol(argv[++i]);
+    else if (arg == "-b" && i + 1 < argc) bootMs = atoll(argv[++i]);
+    else if (arg == "-l" && i + 1 < argc) sim::loopOverheadUs = atol(argv[++i]);
+    else if (arg == "-w" && i + 1 < argc) wavPath = argv[++i];
+    else if (arg == "-c" && i + 1 < argc) sim::setCommandLoss(atol(argv[++i]));
+    else if (arg == "-d" && i + 1 < argc) dumpPath = argv[++i];
+    else if (arg == "-r" && i + 1 < argc) replayPath = argv[++i];
+    else if (arg == "-p") profile = true;
+    else if (arg == "-t") _logTracks = true;
+    else if (arg == "-v") sim::setVerbose(true);
+    else {
+      usage(argv[0]);
+      return arg == "-h" ? 0 : 1;
+    }
+  }
+
+  std::vector<action> script;
+  if (scriptPath && !loadScript(scriptPath, script)) return 1;
+
+  std::vector<traceEvent> recorded;
+  if (replayPath && !loadDump(replayPath, recorded)) return 1;
+
+  sim::reset();
+  sim::setTrackListener(onTrack);
+  sim::setDebugListener(onDebug);
+  if (replayPath) return replayDump(recorded) ? 2 : 0;
+  sim::capturePcm(wavPath != NULL);
+  auto wallStart = std::chrono::steady_clock::now();
+
+  sim::runSetup();
+#if ENABLE_EASY_AUDIO_PCM == 1
+  audio.setTrackStartCallback(onSoundStart);
+#endif
+  sim::runUntil(bootMs * 1000);
+
+  // leave setup out of the profile and the loop times
+  if (profile) sim::consoleRx("pl");
+  uint64_t offset = sim::now();
+  for (long r = 0; r < repeats; r++) {
+    uint64_t scriptEnd = 0;
+    memset(_trackCounts, 0, sizeof(_trackCounts));
+    for (size_t i = 0; i < script.size(); i++) {
+      const action& a = script[i];
+      sim::runUntil(offset + a.at * 1000);
+      if (a.level >= 0) sim::setPin(TRIGGER_PIN, a.level);
+      if (a.level == ACTION_DUMP) sim::consoleRx("t");
+      if (a.level == ACTION_LOSE) sim::loseCommand(a.count);
+      if (a.level == ACTION_MISSING) sim::setMissingTrack(a.track);
+      if (a.level == ACTION_EXPECT && _trackCounts[a.track & 0xFF] != a.count) {
+        fprintf(stderr, "%llu ms: track %u played %u times, expected %u\n", (unsigned long long)a.at,
+                a.track, _trackCounts[a.track & 0xFF], a.count);
+        _expectFailed++;
+      }
+      scriptEnd = a.at;
+    }
+    sim::setPin(TRIGGER_PIN, HIGH);
+    offset += (scriptEnd + 1000) * 1000;
+    sim::runUntil(offset);
+  }
+
+  if (profile) {
+    sim::consoleRx("pl");
+    sim::runUntil(sim::now() + 200000);
+  }
+
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double virt = sim::now() / 1e6;
+  printf("virtual time:   %.3f s\n", virt);
+  printf("wall time:      %.3f s (%.0fx real time)\n", wall, wall > 0 ? virt / wall : 0.0);
+  printf("tracks played:  %u\n", sim::tracksPlayed() + _soundsStarted);
+  printf("audio bytes:    %u\n", sim::audioTxBytes());
+  printf("led shows:      %u\n", sim::showCount());
+  if (dumpPath) {
+    FILE* f = _lastDump.empty() ? NULL : fopen(dumpPath, "w");
+    if (_lastDump.empty()) fprintf(stderr, "no trace dump, add a dump to the script\n");
+    else if (!f) fprintf(stderr, "cannot write %s\n", dumpPath);
+    else {
+      fputs(_lastDump.c_str(), f);
+      fclose(f);
+      printf("trace dump:     written to %s\n", dumpPath);
+    }
+  }
+  if (profile) {
+    if (_lastProfile.empty()) fprintf(stderr, "no profile, build with ENABLE_EASY_PROFILE=1\n");
+    else fputs(_lastProfile.c_str(), stdout);
+    fputs(_lastLoop.c_str(), stdout);
+  }
+  if (wavPath) {
+    if (!sim::pcmSamples()) fprintf(stderr, "no PCM output, build with ENABLE_EASY_AUDIO_PCM=1\n");
+    else if (!sim::writeWav(wavPath)) fprintf(stderr, "cannot write %s\n", wavPath);
+    else printf("pcm samples:    %zu written to %s\n", sim::pcmSamples(), wavPath);
+  }
+  return _expectFailed ? 1 : 0;
+}
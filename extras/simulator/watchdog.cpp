@@ -0,0 +1,124 @@
+/*
+ * name:  watchdog.cpp
+ * Description: Checks the watchdog record of the blaster sketch, built with
+ *              ENABLE_EASY_WATCHDOG=1, on the virtual clock.
+ *
+ * The sketch boots as it would after a watchdog reset: the watchdog running at
+ * 15ms, WDRF set in MCUSR and the record the watchdog interrupt left in .noinit.
+ * setup() has to stop the watchdog before it times out, report the reset and the
+ * task, clear the record and MCUSR, and start the watchdog again, which the loop
+ * then keeps from timing out. A watchdog interrupt that the loop outlives is a
+ * stall, and its record is cleared.
+ *
+ * Then the record is read by its own monitor after each kind of start up:
+ *   power on            - PORF, and whatever was left in the record
+ *   watchdog reset      - WDRF, with and without the interrupt's record
+ *   external reset      - EXTRF, after the interrupt saved a record
+ *   bootloader          - the flags cleared before setup, the record decides
+ * Exits 1 when a check fails.
+ */
+#include <string.h>
+
+#include "sim.h"
+#include <Arduino.h>
+#include <avr/wdt.h>
+#include "config.h"
+#include "easymonitor.h"
+
+extern EasyWatchdogRecord watchdogRecord;
+extern EasyLoopMonitor loopMonitor;
+extern "C" void WDT_vect(void);
+
+static int _failed = 0;
+
+static void expect(bool ok, const char* what) {
+  printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) _failed++;
+}
+
+static bool isCause(const __FlashStringHelper* cause, const char* name) {
+  return strcmp(reinterpret_cast<const char*>(cause), name) == 0;
+}
+
+// a monitor reads the record after a start up with the reset flags
+static bool startUp(EasyWatchdogRecord& record, uint8_t flags, EasyLoopMonitor& monitor) {
+  MCUSR = flags;
+  EasyLoopMonitor::saveResetFlags(record);
+  monitor.beginWatchdog(record, WDTO_1S);
+  return monitor.isWatchdogReset();
+}
+
+// the sketch starts the watchdog, then hangs in the task until the interrupt
+static void hang(EasyWatchdogRecord& record, const __FlashStringHelper* task) {
+  EasyLoopMonitor monitor;
+  startUp(record, _BV(PORF), monitor);
+  monitor.watchdogInterrupt(task);
+}
+
+static void checkSketch() {
+  watchdogRecord.magic = EasyLoopMonitor::WATCHDOG_MAGIC;
+  watchdogRecord.task = F("leds");
+  watchdogRecord.time = 1234;
+  sim::reset();
+  sim::afterWatchdogReset();
+  sim::runSetup();
+  expect(sim::watchdogExpired() == 0, "setup stops the watchdog before it times out");
+  expect(loopMonitor.isWatchdogReset(), "setup reports the watchdog reset");
+  expect(isCause(loopMonitor.getResetCause(), "leds"), "setup reports the task that hung");
+  expect(watchdogRecord.magic == 0 && watchdogRecord.resetFlags == 0, "setup clears the record");
+  expect(MCUSR == 0, "setup clears MCUSR");
+  expect(sim::watchdogRunning(), "setup starts the watchdog");
+
+  sim::runUntil(sim::now() + 5000000);
+  expect(sim::watchdogExpired() == 0, "the loop resets the watchdog in time");
+
+  WDT_vect();
+  expect(watchdogRecord.magic == EasyLoopMonitor::WATCHDOG_MAGIC, "the interrupt saves a record");
+  sim::runUntil(sim::now() + 100000);
+  expect(watchdogRecord.magic == 0, "the loop coming back clears the record");
+}
+
+static void checkRecord() {
+  EasyWatchdogRecord record;
+  record.magic = EasyLoopMonitor::WATCHDOG_MAGIC;
+  record.task = F("audio");
+  record.time = 99;
+  {
+    EasyLoopMonitor monitor;
+    expect(!startUp(record, _BV(PORF), monitor), "power on with a stale record is not a watchdog reset");
+    expect(MCUSR == 0 && !record.magic, "power on clears MCUSR and the record");
+  }
+  {
+    hang(record, F("heat"));
+    EasyLoopMonitor next;
+    expect(!startUp(record, _BV(EXTRF), next), "external reset after the interrupt is not a watchdog reset");
+  }
+  {
+    hang(record, F("heat"));
+    EasyLoopMonitor next;
+    expect(startUp(record, _BV(WDRF), next) && isCause(next.getResetCause(), "heat"),
+           "watchdog reset after the interrupt names the task");
+    EasyLoopMonitor again;
+    expect(!startUp(record, 0, again), "the next reset finds the record cleared");
+  }
+  {
+    EasyLoopMonitor monitor;
+    expect(startUp(record, _BV(WDRF), monitor) && isCause(monitor.getResetCause(), "loop"),
+           "watchdog reset without the interrupt names no task");
+  }
+  {
+    hang(record, F("trigger"));
+    EasyLoopMonitor next;
+    expect(startUp(record, 0, next) && isCause(next.getResetCause(), "trigger"),
+           "flags cleared by the bootloader, the record decides");
+    EasyLoopMonitor again;
+    expect(!startUp(record, 0, again), "flags cleared by the bootloader, no record");
+  }
+}
+
+int main() {
+  checkSketch();
+  checkRecord();
+  if (_failed) fprintf(stderr, "watchdog: %d checks failed\n", _failed);
+  return _failed ? 1 : 0;
+}
@@ -10,6 +10,11 @@
 #include "easycounter.h"
 #include "easyaudio.h"
 #include "easyledv3.h"
+#include "easyscheduler.h"
+#include "easyevent.h"
+#include "easyheat.h"
+#include "easytrace.h"
+#include "easymonitor.h"
 
 /**
  * All components are controlled or enabled by "config.h". Before running, 
@@ -21,42 +26,139 @@ EasyAudio audio(AUDIO_RX_PIN, AUDIO_TX_PIN);
 EasyButton trigger(TRIGGER_PIN);
 
 EasyLedv3<FIRE_LED_CNT, FIRE_LED_PIN> fireLed;
-ezBlasterShot blasterShot(fireLed.RED, fireLed.ORANGE);  // initialize colors to starting fire mode
+ezBlasterShot blasterShot(fireLed.RED, fireLed.ORANGE);  // the colors are set from AMMO_MODES in setup
 
-EasyCounter fireCounter;
-EasyCounter stunCounter;
+EasyCounter ammoCounter;
+EasyHeat heat;
+EasyTrace<TRACE_EVENTS> trace;
+#if ENABLE_DEBUG == 1
+EasyLog<LOG_BUFFER> debugLog(Serial);
+#endif
+#if ENABLE_EASY_PROFILE == 1
+EasyProfile profiler;
+#endif
+EasyLoopMonitor loopMonitor;
+#if ENABLE_EASY_WATCHDOG == 1
+EasyWatchdogRecord watchdogRecord __attribute__((section(".noinit")));   // kept over a watchdog reset
+#endif
+
+/**
+ * Main loop tasks, in priority order. Periods and deadlines are in microseconds.
+ * The led task polls the pattern, which paces its own frames at the pattern frame rate.
+ */
+EasyScheduler<9> scheduler;
+static const unsigned long TASK_TRIGGER_PERIOD  = 1000;      // sample the trigger at 1kHz
+static const uint16_t      TASK_TRIGGER_DEADLINE = 1000;
+static const uint16_t      TASK_CYCLE_DEADLINE  = 1000;      // the period is set from the ammo mode rpm
+static const unsigned long TASK_BLASTER_PERIOD  = 0;         // handle events as soon as they are posted
+static const unsigned long TASK_HEAT_PERIOD     = HEAT_TICK_MS * 1000UL;
+static const unsigned long TASK_LED_PERIOD      = 0;         // run led commands as soon as they are posted
+static const uint16_t      TASK_LED_DEADLINE    = 2000;
+static const unsigned long TASK_AUDIO_PERIOD    = 0;         // drain the audio queue on every pass
+static const unsigned long TASK_STATS_PERIOD    = 1000000;   // report the timing of a task every sec
+static const unsigned long TASK_CONSOLE_PERIOD  = 100000;    // check the debug console for commands
+static const unsigned long TASK_LOG_PERIOD      = 0;         // send the debug log as the port has room
+static const int           CONSOLE_LINE_ROOM    = 32;        // bytes free in the port before a report line is sent
+
+/**
+ * The main loop is a pipeline, each stage is one of the tasks above:
+ *   trigger - turns trigger states into input events
+ *   cycle   - only runs during a burst or full auto, posts an event per follow-up shot
+ *   blaster - the state machine, turns input events into audio and led commands
+ *   heat    - cools the barrel, ends an overheat lockout
+ *   leds    - runs the led commands, then the pattern
+ *   audio   - runs the audio commands, then sends queued bytes to the player
+ * The stages only share the queues below. New inputs, eg. a reload switch, post
+ * their own events and the blaster handles them, without touching the outputs.
+ */
+// input events
+static const uint8_t EVENT_FIRE_PRESSED   = 1;   // trigger pulled
+static const uint8_t EVENT_HOLD_STARTED   = 2;   // trigger held for THEME_HOLD_TIME
+static const uint8_t EVENT_LONG_RELEASED  = 3;   // trigger released after a long press, before the theme
+static const uint8_t EVENT_FIRE_RELEASED  = 4;   // trigger released after a short press, or after the theme
+static const uint8_t EVENT_CYCLE_SHOT     = 5;   // the next shot of a burst or full auto is due
+// audio commands, the param is the track
+static const uint8_t AUDIO_CMD_PLAY       = 1;
+static const uint8_t AUDIO_CMD_PLAY_ONCE  = 2;   // unless the track is still playing
+// led commands
+static const uint8_t LED_CMD_SHOT         = 1;   // the param is the heat level, 0-255
+static const uint8_t LED_CMD_COLORS       = 2;   // the param is the row in AMMO_MODES
+
+// blaster states
+static const uint8_t BLASTER_READY        = 0;
+static const uint8_t BLASTER_EMPTY        = 1;   // shots dry fire until the next reload
+
+static const unsigned long THEME_HOLD_TIME = 6000;   // ms the trigger is held to play the theme
+static const uint8_t BLASTER_EVENTS_PER_RUN = 4;     // bounds the time of one blaster run
+static const uint8_t BURST_HELD = 255;               // cycleShots for full auto, fires until the release
+
+EasyEventQueue<8> inputEvents;
+EasyEventQueue<4> audioCommands;
+EasyEventQueue<4> ledCommands;
 
 
 /**
  *   Variables for tracking trigger state
  *   Variables must be marked as volatile because they are updated in the ISR.
  */
-uint8_t selectedTriggerMode = AMMO_MODE_FIRE;  // sets the fire mode to blaster to start
+uint8_t selectedTriggerMode = AMMO_MODE_START;  // row of AMMO_MODES in use
+AmmoMode ammoMode;                                // RAM copy of the row, read on every shot
+uint8_t blasterState = BLASTER_READY;
+unsigned long lastShotTime = 0;                   // ms of the last shot, for the ammo mode rpm
+uint8_t cycleShots        = 0;                     // follow-up shots left in a burst, or BURST_HELD
+bool autoFired            = 0;                     // full auto fired during this press
+int8_t cycleTask          = -1;                    // scheduler id of the cycle task
+unsigned long cyclePeriod = 0;                     // us between follow-up shots of a cold barrel
+bool ventPlayed           = 0;                     // vent sound queued for this overheat
 bool playStartupTrack     = 1;                     // play power up sound on startup
-bool activateThemeTrack   = 0;                     // play theme track
+bool themeHoldPosted      = 0;                     // hold event sent for this press
+unsigned long firstShotTime = 0;                   // ms from power on to the first trigger pull
+char consoleReport        = 0;                     // console command whose report is being sent
+uint16_t consoleLine      = 0;                     // next line of the report
 
 /**
  * function declarations
  */
 // main loop functions
 void powerUp(void);
+void updateTrigger(void);
+void updateCycle(void);
+void updateBlaster(void);
+void updateHeat(void);
+void updateLeds(void);
+void updateAudio(void);
+void reportTaskStats(void);
+void updateConsole(void);
+void updateLog(void);
+bool printReportLine(void);
 bool checkTriggerSwitch(void);
 void handleLedDisplay(void);
 void handleAmmoDown(void);
+void handleCycleShot(void);
+bool fireShot(void);
+void stopCycle(void);
 void setNextAmmoMode();
 void changeAmmoMode(int mode);
+void loadAmmoMode(uint8_t mode);
 void reloadAmmo(void);
+void setShotColors(uint8_t mode, uint8_t heatStep);
 // convenience functions
-EasyCounter& getTriggerCounter();
 uint8_t getSelectedTrack(uint8_t idx);
 
 void setup() {
+#if ENABLE_EASY_WATCHDOG == 1
+  // a watchdog reset leaves the watchdog running at 15ms, stop it before anything else
+  EasyLoopMonitor::saveResetFlags(watchdogRecord);
+#endif
   Serial.begin(115200);
-  DBGLN(F("Starting setup"));
+  LOG(BLASTER, INFO, F("Starting setup"));
+  trace.record(easytrace::BOOT);
+
+  // Load the starting ammo mode, its clip and shot colors
+  loadAmmoMode(AMMO_MODE_START);
 
-  // Initialize the ammo counters for different modes
-  fireCounter.begin(0, 10, EasyCounter::COUNTER_MODE_DOWN);
-  stunCounter.begin(0, 10, EasyCounter::COUNTER_MODE_DOWN);
+  // start with a cold barrel
+  heat.begin(HEAT_PER_SHOT, HEAT_DECAY_SHIFT, HEAT_OVERHEAT, HEAT_COOLED);
 
   //initializes the audio player and sets the volume to max
   audio.begin(30);
@@ -67,6 +169,31 @@ void setup() {
 
   // set up the fire trigger and the debounce threshold
   trigger.begin(25);
+
+  // queue the start up tracks, they play once the audio player is ready
+  powerUp();
+
+  // register the main loop tasks
+  scheduler.addTask(updateTrigger, TASK_TRIGGER_PERIOD, TASK_TRIGGER_DEADLINE, F("trigger"));
+  cycleTask = scheduler.addTask(updateCycle, 0, TASK_CYCLE_DEADLINE, F("cycle"));
+  scheduler.stopTask(cycleTask);   // started by a burst or full auto pull
+  scheduler.addTask(updateBlaster, TASK_BLASTER_PERIOD, 0, F("blaster"));
+  scheduler.addTask(updateHeat, TASK_HEAT_PERIOD, 0, F("heat"));
+  scheduler.addTask(updateLeds, TASK_LED_PERIOD, TASK_LED_DEADLINE, F("leds"));
+  scheduler.addTask(updateAudio, TASK_AUDIO_PERIOD, 0, F("audio"));
+#if ENABLE_DEBUG == 1
+  scheduler.addTask(reportTaskStats, TASK_STATS_PERIOD, 0, F("stats"));
+  scheduler.addTask(updateConsole, TASK_CONSOLE_PERIOD, 0, F("console"));
+  scheduler.addTask(updateLog, TASK_LOG_PERIOD, 0, F("log"));
+#endif
+
+  // time the loop from here, and start the watchdog once setup is done
+  loopMonitor.begin(LOOP_STALL_US);
+#if ENABLE_EASY_WATCHDOG == 1
+  loopMonitor.beginWatchdog(watchdogRecord, WATCHDOG_TIMEOUT);
+  if (loopMonitor.isWatchdogReset())
+    LOG(CORE, ERROR, F("Watchdog reset in "), loopMonitor.getResetCause());
+#endif
 }
 
 /**
@@ -82,37 +209,261 @@ void setup() {
  *          1. Flash white
  *          2. Burn Red to orange, then fade as it cools
  *    d. Otherwise queue empty clip track
+ *    e. Bursts and full auto fire the next shots from the cycle task, at the
+ *       ammo mode rpm
  *  2. Check the ammo mode change
  *    a. Resets all counters
  *    b. Plays change mode audio track
+ *  3. Send any queued audio commands to the player
+ *
+ *  Each step is a scheduler task with its own period, see setup(), and the
+ *  steps pass events and commands down the pipeline through queues. The time
+ *  of each pass is checked, and a stall is logged with the task that caused it.
  */
 void loop(void) {
-  powerUp();
-  // Update the triggers LEDS in case they were activated. This should always be run in the main loop.
-  fireLed.updateDisplay();
-// check the trigger for input  
+  PROFILE_SCOPE(easyprofile::LOOP);
+  scheduler.run();
+  if (loopMonitor.check(scheduler.getSlowestTask()))
+    LOG(CORE, WARN, F("Loop stall (us): "), loopMonitor.getLastStall(), F(" in "), loopMonitor.getLastCause());
+}
+
+#if ENABLE_EASY_WATCHDOG == 1
+/**
+ * The loop has not come back for WATCHDOG_TIMEOUT, save the task it is in. The
+ * Nano resets on the next time out.
+ */
+ISR(WDT_vect) {
+  loopMonitor.watchdogInterrupt(scheduler.getCurrentTask());
+}
+#endif
+
+#if ENABLE_EASY_AUDIO_PCM == 1
+/**
+ * Mixes the next sample, at easymixer::SAMPLE_RATE.
+ */
+ISR(TIMER1_COMPA_vect) {
+  EasyMixer::isr();
+}
+#endif
+
+/**
+ * Check the trigger for input
+ */
+void updateTrigger(void) {
   checkTriggerSwitch();
 }
 
 /**
- * Playback a powerup track on start up. This can be called many times.
+ * Paces the follow-up shots of a burst or full auto. The task period is the shot
+ * interval, so the fire rate depends on the scheduler, not on how long a pass takes.
+ */
+void updateCycle(void) {
+  inputEvents.post(EVENT_CYCLE_SHOT);
+}
+
+/**
+ * The blaster state machine. Handles a few input events per run, the rest wait
+ * for the next pass.
+ */
+void updateBlaster(void) {
+  EasyEvent e;
+  for (uint8_t i = 0; i < BLASTER_EVENTS_PER_RUN && inputEvents.next(e); i++) {
+    switch (e.type) {
+      case EVENT_FIRE_PRESSED:
+        handleAmmoDown();
+        break;
+      case EVENT_CYCLE_SHOT:
+        handleCycleShot();
+        break;
+      case EVENT_FIRE_RELEASED:
+        // a burst carries on after the release, full auto stops
+        if (cycleShots == BURST_HELD) stopCycle();
+        break;
+      case EVENT_HOLD_STARTED:
+        // let the theme carry on if it is still playing from the last hold
+        audioCommands.post(AUDIO_CMD_PLAY_ONCE, AUDIO_TRACK_THEME);
+        break;
+      case EVENT_LONG_RELEASED:
+        // a full auto hold is not a request to change the mode
+        if (cycleShots == BURST_HELD) stopCycle();
+        if (!autoFired) setNextAmmoMode();
+        break;
+    }
+  }
+}
+
+/**
+ * Cools the barrel by one tick. The vent starts on the tick after the shot that
+ * overheated, so the player is not told to drop the shot for the vent.
+ */
+void updateHeat(void) {
+  if (heat.isOverheated() && !ventPlayed) {
+    ventPlayed = 1;
+    audioCommands.post(AUDIO_CMD_PLAY, AUDIO_TRACK_VENT);
+  }
+  if (heat.tick()) {
+    LOG(BLASTER, INFO, F("Cooled down"));
+    trace.record(easytrace::HEAT, 0);
+    ventPlayed = 0;
+  }
+}
+
+/**
+ * Run the led commands, update the triggers LEDS in case they were activated,
+ * then push any changed pixels out. This is the only place the strip is written.
+ */
+void updateLeds(void) {
+  static uint8_t ledMode = 0;
+  static uint8_t heatStep = 0;
+  uint8_t phase = blasterShot.getPhase();
+  EasyEvent e;
+  while (ledCommands.next(e)) {
+    if (e.type == LED_CMD_SHOT) {
+      // the colors only change when the heat moves to the next step
+      uint8_t step = (uint8_t)e.param >> 5;
+      if (step != heatStep) {
+        heatStep = step;
+        setShotColors(ledMode, heatStep);
+      }
+      fireLed.activate(blasterShot);
+    } else if (e.type == LED_CMD_COLORS) {
+      ledMode = e.param;
+      setShotColors(ledMode, heatStep);
+    }
+  }
+  fireLed.updateDisplay();
+  fireLed.commit();
+  if (blasterShot.getPhase() != phase)
+    trace.record(easytrace::LED, blasterShot.getPhase());
+}
+
+/**
+ * Sets the shot colors from the mode table, blended toward HEAT_COLOR by the
+ * heat step, 0-7.
+ */
+void setShotColors(uint8_t mode, uint8_t heatStep) {
+  const AmmoMode* row = &AMMO_MODES[mode];
+  CRGB hot(HEAT_COLOR);
+  uint8_t amount = heatStep * 24;   // up to 2/3 of the way to white hot
+  blasterShot.initialize(blend(CRGB(pgm_read_dword(&row->startColor)), hot, amount),
+                         blend(CRGB(pgm_read_dword(&row->endColor)), hot, amount),
+                         pgm_read_byte(&row->speed), pgm_read_byte(&row->curve));
+}
+
+/**
+ * Run the audio commands, then send queued player commands a few bytes at a time.
+ */
+void updateAudio(void) {
+  EasyEvent e;
+  while (audioCommands.next(e)) {
+    if (e.type == AUDIO_CMD_PLAY_ONCE && audio.isPlaying(e.param))
+      continue;
+    trace.record(easytrace::AUDIO, e.param);
+    audio.playTrack(e.param);
+  }
+  audio.update();
+}
+
+/**
+ * Log the worst-case execution time of the next task, then the dropped events
+ * and log lines after the last task. One line a run fits in the log buffer.
+ */
+void reportTaskStats(void) {
+#if ENABLE_DEBUG == 1
+  static uint8_t task = 0;
+  if (task < scheduler.getTaskCount()) {
+    if (LOG_ON(CORE, INFO)) scheduler.printStats(debugLog, task);
+    task++;
+    return;
+  }
+  task = 0;
+  LOG(CORE, INFO, F("Events dropped: "), inputEvents.getDropped() + audioCommands.getDropped() + ledCommands.getDropped());
+  LOG(CORE, INFO, F("Log lines dropped: "), debugLog.getDropped());
+#endif
+}
+
+/**
+ * Runs the commands sent on the debug console, one character each:
+ *   t - dump the trace
+ *   p - print the profile and start it again, when ENABLE_EASY_PROFILE is 1
+ *   l - print the loop times and stalls, and start them again
+ * The report is sent by the log task a few lines at a time, the next command
+ * waits until it is done.
+ */
+void updateConsole(void) {
+  while (!consoleReport && Serial.available() > 0) {
+    char c = Serial.read();
+    if (c == 't' || c == 'l' || (ENABLE_EASY_PROFILE == 1 && c == 'p')) {
+      consoleReport = c;
+      consoleLine = 0;
+    }
+  }
+}
+
+/**
+ * Sends the waiting lines of the debug log, or the lines of a console report
+ * that fit in the port's transmit buffer. The log waits while a report is sent,
+ * so the report lines stay together.
+ */
+void updateLog(void) {
+#if ENABLE_DEBUG == 1
+  // start a report between log lines, once the log is sent
+  if (consoleReport && (consoleLine || debugLog.size() == 0)) {
+    while (Serial.availableForWrite() >= CONSOLE_LINE_ROOM) {
+      if (!printReportLine()) {
+        consoleReport = 0;
+        break;
+      }
+      consoleLine++;
+    }
+    return;
+  }
+  debugLog.update();
+#endif
+}
+
+/**
+ * Writes the next line of the console report, and starts the profile or the
+ * loop times again after the last one. Returns False when the report is done.
+ */
+bool printReportLine(void) {
+  if (consoleReport == 't')
+    return trace.printLine(Serial, consoleLine);
+#if ENABLE_EASY_PROFILE == 1
+  if (consoleReport == 'p') {
+    if (profiler.printLine(Serial, consoleLine)) return true;
+    profiler.reset();
+    return false;
+  }
+#endif
+  if (consoleReport == 'l') {
+    if (loopMonitor.printLine(Serial, consoleLine)) return true;
+    loopMonitor.reset();
+    return false;
+  }
+  return false;
+}
+
+/**
+ * Queue a powerup track on start up. This can be called many times.
  * It will only play the track once.
  */
 void powerUp(void) {
   if (playStartupTrack) {
-    DBGLN(F("Powering up"));
-#ifndef ENABLE_EASY_AUDIO_PRO
+    LOG(BLASTER, INFO, F("Powering up"));
+#if ENABLE_EASY_AUDIO_PRO == 0 && ENABLE_EASY_AUDIO_PCM == 0
     // This is a hack around specifically for df mini players
     audio.playTrack(AUDIO_TRACK_SILENCE);
-    delay(1000);
+    audio.holdQueue(1000);
 #endif
     audio.playTrack(AUDIO_TRACK_START_UP);
+    audio.keepQueue();   // a shot while the player boots is played after it, not in its place
     playStartupTrack = 0;
   }
 }
 
 /**
- * Checks the fire trigger momentary switch.
+ * Checks the fire trigger momentary switch, and posts the input events.
  * - Immediate press should trigger ammo fire
  * - Press and hold for 6 secs will play theme track
  * - Long press and release should change ammo modes
@@ -122,56 +473,120 @@ bool checkTriggerSwitch(void) {
   int buttonStateFire = trigger.checkState();
   // check if a trigger is pressed.
   if (buttonStateFire == EasyButton::BUTTON_PRESSED) {
-    handleAmmoDown();
-    activateThemeTrack = 0;
-    return true;
+    trace.record(easytrace::BUTTON, 1, trigger.getPressedTime());
+    // the state a replay starts from, when the dump has lost the pulls before this one
+    trace.recordValue(easytrace::STATE, selectedTriggerMode | (heat.isOverheated() ? 0x80 : 0), heat.getHeat());
+    themeHoldPosted = 0;
+    return inputEvents.post(EVENT_FIRE_PRESSED);
+  }
+
+  if (buttonStateFire == EasyButton::BUTTON_SHORT_PRESS) {
+    trace.record(easytrace::BUTTON, 0, trigger.getReleasedTime());
+    return inputEvents.post(EVENT_FIRE_RELEASED);
   }
 
   if (buttonStateFire == EasyButton::BUTTON_HOLD_PRESS) {
-    if (!activateThemeTrack && trigger.pressedLongerThan(6000)) {
-      audio.playTrack(AUDIO_TRACK_THEME);
-      activateThemeTrack = 1;
-      return true;
+    if (!themeHoldPosted && trigger.pressedLongerThan(THEME_HOLD_TIME)) {
+      themeHoldPosted = 1;
+      return inputEvents.post(EVENT_HOLD_STARTED);
     }
   }
 
   if (buttonStateFire == EasyButton::BUTTON_LONG_PRESS) {
-    if (!trigger.pressedLongerThan(6000)) {
-      activateThemeTrack = 0;
-      setNextAmmoMode();
-      return true;
+    trace.record(easytrace::BUTTON, 0, trigger.getReleasedTime());
+    if (!trigger.pressedLongerThan(THEME_HOLD_TIME)) {
+      themeHoldPosted = 0;
+      return inputEvents.post(EVENT_LONG_RELEASED);
     }
+    return inputEvents.post(EVENT_FIRE_RELEASED);
   }
   return false;
 }
 
 /**
- *  Sends a blaster pulse.
+ *  Handles a trigger pull.
+ *    1. Ignores the pull during a burst, an overheat, or sooner than the mode rpm allows
+ *    2. Fires the first shot
+ *    3. Starts the cycle task for the rest of a burst, or for full auto
+ */
+void handleAmmoDown(void) {
+  if (!firstShotTime) {
+    firstShotTime = millis();
+    LOG(BLASTER, INFO, F("First shot (ms): "), firstShotTime);
+  }
+  autoFired = 0;
+  if (cycleShots || heat.isOverheated()) return;
+  // pulls faster than the mode allows are ignored, they don't use ammo
+  if (ammoMode.rpm && lastShotTime && millis() - lastShotTime < 60000UL / ammoMode.rpm)
+    return;
+  if (!fireShot() || ammoMode.shots == 1 || heat.isOverheated())
+    return;
+  cycleShots = ammoMode.shots ? ammoMode.shots - 1 : BURST_HELD;
+  uint16_t rpm = ammoMode.rpm ? ammoMode.rpm : AMMO_AUTO_RPM;
+  cyclePeriod = 60000000UL / rpm;
+  scheduler.startTask(cycleTask, cyclePeriod + (cyclePeriod >> 9) * heat.getLevel());
+}
+
+/**
+ *  Fires the next shot of a burst or full auto, the cycle stops with the burst,
+ *  an empty clip or an overheat. The next shot is up to half as late again as
+ *  the barrel heats up.
+ */
+void handleCycleShot(void) {
+  if (!cycleShots) return;   // posted before the cycle was stopped
+  if (cycleShots == BURST_HELD)
+    autoFired = 1;
+  else
+    cycleShots--;
+  if (!fireShot() || !cycleShots || heat.isOverheated())
+    stopCycle();
+  else
+    scheduler.setPeriod(cycleTask, cyclePeriod + (cyclePeriod >> 9) * heat.getLevel());
+}
+
+void stopCycle(void) {
+  cycleShots = 0;
+  scheduler.stopTask(cycleTask);
+}
+
+/**
+ *  Sends a blaster pulse. Returns False for a dry fire.
  *    1. Toggles a clip counter
  *    2. Checks for an empty clip
  *       a. play empty clip track
  *    3. If clip is not empty
  *       a. queue audio track
  *       b. activate led strip
- *       c. activate oled refresh
- *       d. Check for low ammo
+ *       c. heat the barrel
+ *  Sounds and lights are sent as commands to the audio and led stages, so the
+ *  counter, the sound and the flash of a shot always go together.
  */
-void handleAmmoDown(void) {
+bool fireShot(void) {
+  lastShotTime = millis();
   // move the counter
-  bool emptyClip = !getTriggerCounter().tick();
-  if (emptyClip) {
-    //DBGLN(F("Empty clip"));
-    audio.playTrack(getSelectedTrack(AMMO_MODE_IDX_EMTY));
-    return;
+  if (blasterState == BLASTER_READY && !ammoCounter.tick())
+    blasterState = BLASTER_EMPTY;
+  if (blasterState == BLASTER_EMPTY) {
+    LOG(BLASTER, DEBUG, F("Empty clip"));
+    trace.record(easytrace::DRY);
+    // don't restart the click on every pull, it only adds serial traffic
+    audioCommands.post(AUDIO_CMD_PLAY_ONCE, getSelectedTrack(AMMO_MODE_IDX_EMTY));
+    return false;
   }
-  //DBGLN(F("Ammo fire sequence"));
+  LOG(BLASTER, DEBUG, F("Ammo fire sequence"));
   //play the track
   // alternate between two firing blasts
-  uint8_t idx = getTriggerCounter().getCount() % 2;
-  audio.playTrack(getSelectedTrack(idx));
+  trace.record(easytrace::SHOT, ammoCounter.getCount());
+  uint8_t idx = ammoCounter.getCount() % 2;
+  audioCommands.post(AUDIO_CMD_PLAY, getSelectedTrack(idx));
   // activate the led pulse
-  //DBGLN(F("handleAmmo - activate leds"));
-  fireLed.activate(blasterShot);
+  LOG(BLASTER, DEBUG, F("handleAmmo - activate leds"));
+  ledCommands.post(LED_CMD_SHOT, heat.getLevel());
+  if (heat.addShot()) {
+    LOG(BLASTER, INFO, F("Overheated"));
+    trace.record(easytrace::HEAT, 1);
+  }
+  return true;
 }
 
 /**
@@ -182,10 +597,8 @@ void handleAmmoDown(void) {
  *  4. set screen refresh
  */
 void setNextAmmoMode(void) {
-  // Increment the trigger mode index or reset to 0
-  int mode = selectedTriggerMode + 1;
-  if (mode == 2) mode = 0;
-  changeAmmoMode(mode);
+  // Increment the trigger mode index or wrap to the first row
+  changeAmmoMode((selectedTriggerMode + 1) % AMMO_MODE_COUNT);
 }
 
 /**
@@ -195,23 +608,27 @@ void setNextAmmoMode(void) {
  *  4. reload ammo
  */
 void changeAmmoMode(int mode) {
-  if (mode > -1 && mode < 2) {
-    selectedTriggerMode = mode;
-    // Check for Switching modes
-    if (selectedTriggerMode == AMMO_MODE_FIRE) {
-      blasterShot.initialize(fireLed.RED, fireLed.ORANGE);  // shot - flash with color fade
-      DBGLN(F("Fire Mode selected"));
-    }
-    if (selectedTriggerMode == AMMO_MODE_STUN) {
-      blasterShot.initialize(fireLed.YELLOW, fireLed.WHITE);  // shot - flash with color fade
-      DBGLN(F("Stun Mode selected"));
-    }
-    audio.playTrack(getSelectedTrack(AMMO_MODE_IDX_CHGE));
-    reloadAmmo();
-    delay(100);
+  if (mode > -1 && mode < AMMO_MODE_COUNT) {
+    loadAmmoMode(mode);
+    audioCommands.post(AUDIO_CMD_PLAY, getSelectedTrack(AMMO_MODE_IDX_CHGE));
   }
 }
 
+/**
+ *  Copies a row of AMMO_MODES to RAM, so a shot reads its tracks with a single
+ *  lookup, then sizes the clip, reloads and sends the colors to the led stage.
+ */
+void loadAmmoMode(uint8_t mode) {
+  stopCycle();
+  selectedTriggerMode = mode;
+  memcpy_P(&ammoMode, &AMMO_MODES[mode], sizeof(AmmoMode));
+  trace.record(easytrace::MODE, mode);
+  LOG(BLASTER, INFO, F("Ammo mode selected: "), mode);
+  ammoCounter.begin(0, ammoMode.clipSize, EasyCounter::COUNTER_MODE_DOWN);
+  ledCommands.post(LED_CMD_COLORS, mode);
+  reloadAmmo();
+}
+
 
 /**
  *  Routine for resetting the ammo counters
@@ -221,18 +638,9 @@ void changeAmmoMode(int mode) {
  *  4. activate oled refresh
  */
 void reloadAmmo(void) {
-  //DBGLN(F("Reloading all counters"));
-  fireCounter.resetCount();
-  stunCounter.resetCount();
-}
-
-/**
- *  Routine for getting the selected trigger counter
- */
-EasyCounter& getTriggerCounter() {
-  if (selectedTriggerMode == AMMO_MODE_FIRE)
-    return fireCounter;
-  return stunCounter;
+  LOG(BLASTER, DEBUG, F("Reloading all counters"));
+  ammoCounter.resetCount();
+  blasterState = BLASTER_READY;
 }
 
 /**
@@ -240,5 +648,5 @@ EasyCounter& getTriggerCounter() {
  *  trigger mode and a state variable
  */
 uint8_t getSelectedTrack(uint8_t trackIdx) {
-  return AUDIO_TRACK_AMMO_MODE_ARR[selectedTriggerMode][trackIdx];
+  return ammoMode.tracks[trackIdx];
 }
@@ -9,22 +9,105 @@
  */
 
 // Update these based on the DF player you've included in your circuit
+// These can also be set from the compiler flags, eg. -DENABLE_EASY_AUDIO_PRO=1
+#ifndef ENABLE_EASY_AUDIO_PRO
 #define ENABLE_EASY_AUDIO_PRO        0 // Enable the DF Pro otherwise it assumes DF Mini
+#endif
+#ifndef ENABLE_EASY_AUDIO_MINI_VAR
 #define ENABLE_EASY_AUDIO_MINI_VAR   0 // Enable DF Mini Variant code
+#endif
+// Ask the DF Mini to ACK each command and send it again when the ACK is lost.
+// Each command then waits for its reply, about 10ms longer.
+#ifndef ENABLE_EASY_AUDIO_ACK
+#define ENABLE_EASY_AUDIO_ACK        0 // Enable DF Mini command ACKs
+#endif
+// Play short PCM sound effects from flash instead of using a DF player. Up to four
+// effects are mixed at the same time, output is PWM on PCM_AUDIO_PIN.
+// The effects are in pcm_sounds.h, see extras/pcm_sounds to change them.
+#ifndef ENABLE_EASY_AUDIO_PCM
+#define ENABLE_EASY_AUDIO_PCM        0 // Enable the PCM mixer instead of a DF player
+#endif
 
 // To disable any component set value to 0
+#ifndef ENABLE_DEBUG
 #define ENABLE_DEBUG            1 //Enable Debugging
+#endif
 #define ENABLE_EASY_AUDIO       1 //Enable audio
 #define ENABLE_EASY_LED         1 //Enable LEDs
 #define ENABLE_EASY_BUTTON      1 //Enable triggers
+#ifndef ENABLE_EASY_HEAT
+#define ENABLE_EASY_HEAT        1 //Enable barrel heat and the overheat lockout
+#endif
+#ifndef ENABLE_EASY_TRACE
+#define ENABLE_EASY_TRACE       1 //Enable the trace of button edges, shots, audio and led phases
+#endif
+#ifndef ENABLE_EASY_PROFILE
+#define ENABLE_EASY_PROFILE     0 //Enable the execution time probes, send 'p' on the debug console
+#endif
+#ifndef ENABLE_AMMO_FULL_AUTO
+#define ENABLE_AMMO_FULL_AUTO   0 //Enable the full auto row of AMMO_MODES, see below
+#endif
+#ifndef ENABLE_EASY_WATCHDOG
+#define ENABLE_EASY_WATCHDOG    0 //Enable the hardware watchdog, resets the Nano when the main loop hangs
+#endif
+
+// A loop() pass longer than LOOP_STALL_US is a stall, and is logged with the task that
+// took longest in it. With ENABLE_EASY_WATCHDOG, a pass longer than twice WATCHDOG_TIMEOUT
+// resets the Nano, and the task it hung in is kept over the reset. Send 'l' on the debug
+// console for the loop times, the stalls and the last watchdog reset, see easymonitor.h.
+#define LOOP_STALL_US           20000
+#define WATCHDOG_TIMEOUT        WDTO_1S
+
+// Records kept by the trace, 4 bytes of RAM each. Send 't' on the debug console to
+// dump them, see easytrace.h and extras/simulator to replay a dump. A semi auto shot
+// takes 7 records, so 64 hold about the last 9 pulls. Each pull records the blaster
+// state, so a replay can start from the first pull in the dump.
+#define TRACE_EVENTS            64
+
+// Serial port to the DF player, set AUDIO_SERIAL to one of:
+//   AUDIO_SERIAL_SOFTWARE - SoftwareSerial on AUDIO_RX_PIN and AUDIO_TX_PIN. Interrupts are
+//                           off for each byte, ~1ms at 9600 baud, and 115200 is unreliable
+//   AUDIO_SERIAL_HARDWARE - the hardware UART on pins 0 (RX) and 1 (TX), buffered and
+//                           interrupt driven. The debug output uses it, so ENABLE_DEBUG must be 0
+//   AUDIO_SERIAL_ALT      - AltSoftSerial on pins 8 (RX) and 9 (TX), buffered and interrupt
+//                           driven. Uses Timer1. REQUIRED LIBRARY: AltSoftSerial
+#define AUDIO_SERIAL_SOFTWARE   0
+#define AUDIO_SERIAL_HARDWARE   1
+#define AUDIO_SERIAL_ALT        2
+#ifndef AUDIO_SERIAL
+#define AUDIO_SERIAL        AUDIO_SERIAL_SOFTWARE
+#endif
 
-// Pin configuration for MP3 Player
+// Pin configuration for MP3 Player, only used by AUDIO_SERIAL_SOFTWARE
 #define AUDIO_TX_PIN        5
 #define AUDIO_RX_PIN        4
+// DF Mini BUSY output, LOW while a track plays. Set to 0 if it is not wired, the
+// player's "track finished" reply is used instead.
+#define AUDIO_BUSY_PIN      0
+
+// Pin configuration for the PCM mixer output, must be pin 11 (Timer2 OC2A)
+#define PCM_AUDIO_PIN       11
+
+#if ENABLE_EASY_AUDIO_PCM == 1 && ENABLE_EASY_AUDIO_PRO == 1
+#error "Enable either the PCM mixer or the DF Pro, not both"
+#endif
+#if AUDIO_SERIAL == AUDIO_SERIAL_HARDWARE && ENABLE_DEBUG == 1
+#error "The hardware UART is used by the debug output, set ENABLE_DEBUG to 0 or pick another AUDIO_SERIAL"
+#endif
+#if AUDIO_SERIAL == AUDIO_SERIAL_ALT && ENABLE_EASY_AUDIO_PCM == 1
+#error "AltSoftSerial and the PCM mixer both need Timer1"
+#endif
+#if ENABLE_EASY_AUDIO_PCM == 1 && PCM_AUDIO_PIN != 11
+#error "PCM_AUDIO_PIN must be pin 11, the mixer outputs on Timer2 OC2A"
+#endif
 
 // Pin configuration for all momentary triggers
 #define TRIGGER_PIN         3
 
+// Capture trigger edges with a pin interrupt instead of polling. The pin must
+// support an external interrupt (pins 2 or 3 on the Nano), otherwise it is polled.
+#define ENABLE_EASY_BUTTON_ISR  1
+
 // Pin configuration for front barrel WS2812B LED
 // set these to 0 if you want to disable the component
 #define FIRE_LED_PIN          13
@@ -48,14 +131,72 @@ static const int AUDIO_TRACK_AMMO_RELOAD       =   7;
 static const int AUDIO_TRACK_AMMO_EMPTY        =   8;
 static const int AUDIO_TRACK_SILENCE           =   9;
 static const int AUDIO_TRACK_THEME             =   10;
+static const int AUDIO_TRACK_VENT              =   7;    // overheated, shares the reload effect
+
+/**
+ * Ammo modes, in the order a long press cycles through them. Each row is one mode,
+ * add a row to add a mode.
+ *   start, end - color of the shot after the white flash and the color it fades to, 0xRRGGBB
+ *   speed      - blend steps of the fade, a larger number is a slower fade. The fade is
+ *                cut short above 15, see MAX_FADE_FRAMES in ezPattern.h
+ *   curve      - 0 for a linear fade, 1 to ease out, see ezBlasterShot
+ *   tracks     - fire, fire (alternate), empty clip, change mode
+ *   clip       - shots before the clip is empty
+ *   rpm        - most shots per minute, pulls faster than this are ignored, 0 for no limit.
+ *                Bursts and full auto fire at this rate, AMMO_AUTO_RPM when it is 0.
+ *                Above 600 the white flashes of the shots run together
+ *   shots      - shots per pull: 1 for semi auto, 2 or more for a burst, 0 for full auto
+ *                while the trigger is held
+ * A long press changes the mode, unless it was firing full auto. Empty the clip,
+ * then long press, to change out of a full auto mode. So the full auto row is left
+ * out unless ENABLE_AMMO_FULL_AUTO is 1, eg. -DENABLE_AMMO_FULL_AUTO=1
+ */
+struct AmmoMode {
+  uint32_t startColor;
+  uint32_t endColor;
+  uint8_t speed;
+  uint8_t curve;
+  uint8_t tracks[4];
+  uint8_t clipSize;
+  uint16_t rpm;
+  uint8_t shots;
+};
+
+static const AmmoMode AMMO_MODES[] PROGMEM = {
+  {0xFF0000, 0xFF5F00,   6,    0,   {AUDIO_TRACK_AMMO_FIRE_A, AUDIO_TRACK_AMMO_FIRE_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE}, 10,   0, 1},  // fire - red to orange
+  {0xFFFF00, 0xFFFFFF,   6,    0,   {AUDIO_TRACK_AMMO_STUN_A, AUDIO_TRACK_AMMO_STUN_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE}, 10,   0, 1},  // stun - yellow to white
+#if ENABLE_AMMO_FULL_AUTO == 1
+  {0xFF0000, 0xFF2000,   3,    1,   {AUDIO_TRACK_AMMO_FIRE_A, AUDIO_TRACK_AMMO_FIRE_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE}, 30, 600, 0},  // full auto - 10 shots a second
+#endif
+  // {0xFF5F00, 0xFF0000, 6,    0,   {AUDIO_TRACK_AMMO_FIRE_A, AUDIO_TRACK_AMMO_FIRE_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE}, 12, 600, 3},  // burst of 3
+};
+
+static const uint16_t AMMO_AUTO_RPM = 600;   // bursts and full auto without an rpm
+
+/**
+ * Barrel heat, see easyheat.h. Each shot adds HEAT_PER_SHOT and every HEAT_TICK_MS
+ * the barrel loses 1/2^HEAT_DECAY_SHIFT of its heat, about 1.6 secs to lose two thirds.
+ * Above HEAT_OVERHEAT the blaster vents and locks out until it cools to HEAT_COOLED.
+ * With these values full auto overheats after about 20 shots, semi auto does not.
+ * The shot colors blend toward HEAT_COLOR, and full auto slows by up to half, as it heats up.
+ */
+static const uint16_t HEAT_PER_SHOT     = 5000;
+static const uint8_t  HEAT_DECAY_SHIFT  = 5;
+static const uint16_t HEAT_TICK_MS      = 50;
+static const uint16_t HEAT_OVERHEAT     = 50000;
+static const uint16_t HEAT_COOLED       = 16000;
+static const uint32_t HEAT_COLOR        = 0xFFF0C0;   // white hot
 
 /**
  *  Common constant definitions - DO NOT CHANGE
  */
 #define FASTLED_USE_PROGMEM 1
 
+static const uint8_t AMMO_MODE_COUNT = sizeof(AMMO_MODES) / sizeof(AMMO_MODES[0]);
+static const uint8_t AMMO_MODE_START = 0;   // the mode on power up, the first row
+
 /**
- * Audio track index for lookup array. DO NOT CHANGE
+ * Index of the tracks in AmmoMode. DO NOT CHANGE
  */
 static const uint8_t AMMO_MODE_IDX_FIRE_1  =      0;  // fire
 static const uint8_t AMMO_MODE_IDX_FIRE_2  =      1;  // fire
@@ -63,46 +204,64 @@ static const uint8_t AMMO_MODE_IDX_EMTY    =      2;  // empty clip
 static const uint8_t AMMO_MODE_IDX_CHGE    =      3;  // change mode
 
 /**
- * Lookup array for audio tracks based on ammo mode. DO NOT CHANGE
+ * Debug log, see easylog.h. Each message has a module and a level, and the messages
+ * above the level of their module are left out at compile time. The rest wait in a
+ * LOG_BUFFER byte buffer and go out as the debug port has room, a message that does
+ * not fit is dropped. Set LOG_LEVEL for all the modules, or the level of one module,
+ * from the compiler flags, eg. -DLOG_LEVEL_AUDIO=4 to log each frame sent to the player.
+ *   BLASTER - the main loop, shots, modes and heat
+ *   AUDIO   - the audio player and its serial port
+ *   LED     - the led patterns
+ *   CORE    - the scheduler and the event queues
  */
-static const uint8_t AUDIO_TRACK_AMMO_MODE_ARR[2][4]  =  {
-  {AUDIO_TRACK_AMMO_FIRE_A, AUDIO_TRACK_AMMO_FIRE_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE},
-  {AUDIO_TRACK_AMMO_STUN_A, AUDIO_TRACK_AMMO_STUN_B, AUDIO_TRACK_AMMO_EMPTY, AUDIO_TRACK_AMMO_CHANGE_MODE}
-};
-
-/**
- * Audio track index for lookup array. DO NOT CHANGE
- */
-static const uint8_t AMMO_MODE_FIRE = 1;
-static const uint8_t AMMO_MODE_STUN = 2;
+#define LOG_LEVEL_NONE          0
+#define LOG_LEVEL_ERROR         1
+#define LOG_LEVEL_WARN          2
+#define LOG_LEVEL_INFO          3
+#define LOG_LEVEL_DEBUG         4
+#ifndef LOG_LEVEL
+#define LOG_LEVEL               LOG_LEVEL_INFO
+#endif
+#ifndef LOG_LEVEL_BLASTER
+#define LOG_LEVEL_BLASTER       LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_AUDIO
+#define LOG_LEVEL_AUDIO         LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_LED
+#define LOG_LEVEL_LED           LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_CORE
+#define LOG_LEVEL_CORE          LOG_LEVEL
+#endif
+#define LOG_BUFFER              96
 
 /**
  * DEBUG Macros
+ *   LOG(module, level, message[, number[, base]]) - logs a line
+ *   LOG(module, level, message, value, message, value) - logs a line of four parts
+ *   LOG_ON(module, level) - True when the messages of the level are kept, eg. to
+ *                           guard a message that takes more than one print
  */
-extern inline void DBGLOG(const char* message) {
-#if ENABLE_DEBUG == 1
-   Serial.println(message);
-#endif
-}
-extern inline void DBGLN(const __FlashStringHelper* message) {
-#if ENABLE_DEBUG == 1
-   Serial.println(message);
-#endif
-}
-extern inline void DBGCH(char ch) {
+#include "easylog.h"
+#define LOG_ON(module, level)   (ENABLE_DEBUG == 1 && LOG_LEVEL_##level <= LOG_LEVEL_##module)
 #if ENABLE_DEBUG == 1
-   Serial.print(ch);
+extern EasyLog<LOG_BUFFER> debugLog;
+#define LOG(module, level, ...) do { if (LOG_ON(module, level)) debugLog.line(__VA_ARGS__); } while (0)
+#else
+#define LOG(module, level, ...) do {} while (0)
 #endif
-}
-extern inline void DBGHEX(unsigned int ch) {
-#if ENABLE_DEBUG == 1
-   Serial.print(ch, HEX);
-#endif
-}
-extern inline void DBGSTR(const __FlashStringHelper* message) {
-#if ENABLE_DEBUG == 1
-   Serial.print(message);
+
+/**
+ * Profile probes, see easyprofile.h. PROFILE_SCOPE(probe) times the rest of the
+ * block it is in, and is left out unless ENABLE_EASY_PROFILE is 1.
+ */
+#include "easyprofile.h"
+#if ENABLE_EASY_PROFILE == 1
+extern EasyProfile profiler;
+#define PROFILE_SCOPE(probe)    EasyProfileScope _profileScope(profiler, probe)
+#else
+#define PROFILE_SCOPE(probe)    do {} while (0)
 #endif
-}
 
 #endif
@@ -2,6 +2,7 @@
 #define dfplayermini_h
 
 #include <Arduino.h>
+#include "easyqueue.h"
 
 /**
  *  Namespace for constants
@@ -16,12 +17,43 @@ const uint8_t FEEDBACK = 1;     // feedback requested
 const uint8_t NO_FEEDBACK = 0;  // no feedback requested
 const uint8_t EB = 0xEF;        // end byte
 
+/** Transmit Queue */
+const uint8_t QUEUE_SIZE = 4;            // number of command frames that can be waiting to be sent
+const uint8_t TX_BYTES_PER_UPDATE = 2;   // bytes written per call to update(), ~1ms each at 9600 baud
+const uint16_t COMMAND_GAP = 30;         // ms the player needs between two commands
+const uint16_t RESET_GAP = 200;          // ms the player needs to come back after a reset
+
 /** Control Command Values */
 const uint8_t RESET  = 0x0c;
 const uint8_t VOLUME = 0x06;
 const uint8_t USE_MP3_FOLDER = 0x12;
+
+/** Receive */
+const uint16_t ACK_TIMEOUT = 100;        // ms to wait for an ACK before the command is sent again
+const uint8_t MAX_RETRIES = 2;           // times a command is sent again before it is given up
+
+/** Reply Values */
+const uint8_t CARD_INSERTED = 0x3A;
+const uint8_t CARD_REMOVED  = 0x3B;
+const uint8_t FINISHED_USB  = 0x3C;      // track on the USB drive finished playing
+const uint8_t FINISHED_SD   = 0x3D;      // track on the SD card finished playing
+const uint8_t ONLINE        = 0x3F;      // sent after power on or a reset
+const uint8_t ERR           = 0x40;      // the param is one of the error values
+const uint8_t ACK           = 0x41;      // sent for commands with feedback requested
+
+/** Error Values */
+const uint8_t ERROR_BUSY       = 0x01;   // still starting up
+const uint8_t ERROR_SLEEPING   = 0x02;
+const uint8_t ERROR_SERIAL     = 0x03;   // frame not received in full
+const uint8_t ERROR_CHECKSUM   = 0x04;
+const uint8_t ERROR_TRACK      = 0x05;   // track number out of range
+const uint8_t ERROR_NOT_FOUND  = 0x06;   // track not found
+const uint8_t ERROR_NO_ACK     = 0xF0;   // local, no ACK after MAX_RETRIES
+const uint8_t ERROR_QUEUE_FULL = 0xF1;   // local, the command was dropped
 }
 
+typedef void (*reply_callback)(uint8_t reply, uint16_t param);  // called for each reply from the player
+
 
 /**
  *  Class for interacting with DFPlayerMini MP3 player based on the DFPlayerMini_Fast.
@@ -34,6 +66,28 @@ const uint8_t USE_MP3_FOLDER = 0x12;
  *  to interface with the breakout. An external power supply and output amp
  *  improves the MP3 player's functionality. Also, see <a href="https://wiki.dfrobot.com/DFPlayer_Mini_SKU_DFR0299">
  *  the wiki</a> for more detailed wiring instructions.
+ *
+ *  Commands are never written directly. Each command is built into a frame and
+ *  added to a small transmit queue, which is drained a few bytes at a time by
+ *  calling update() from the main loop. On a buffered port, eg. the hardware UART,
+ *  update() writes as many bytes as availableForWrite() says fit instead. The gap the player needs between two
+ *  commands is tracked with a timestamp, so no call on this class blocks.
+ *
+ *  update() also reads the replies, a byte at a time into recStack. Frames with a
+ *  bad checksum are dropped. The card state, the last error and the "track finished"
+ *  count are kept, and every reply can be passed on to a callback:
+ *  eg. player.setCallback(onPlayerReply);
+ *
+ *  With feedback on, the player is asked to ACK each command. A command that is
+ *  not ACKed within ACK_TIMEOUT, or is refused while the player is busy, is sent
+ *  again up to MAX_RETRIES times, and the next command waits for it. This costs a
+ *  reply per command, about 10ms at 9600 baud.
+ *  eg. player.setFeedback(true);
+ *
+ *  A play or volume command replaces one of the same kind that is still waiting in
+ *  the queue, so only the newest is sent. Frames held back by hold() or a reset are
+ *  not replaced, the hold keeps the commands on each side of it in order. A volume
+ *  that matches the last one requested is not sent at all.
  */
 class DFPlayerMini {
 public:
@@ -47,15 +101,16 @@ class DFPlayerMini {
    *  Configure the class.
    *    stream
    *      A reference to the Serial instance (hardware or software) used to communicate with the MP3 player.
-   *    debug
-   *      Boolean used to specify if debug prints should be automatically printed to the serial monitor.
-   *    threshold
-   *      Number of ms allowed for the MP3 player to respond (timeout) to a query.
+   *    variant
+   *      Boolean used to specify the chip variant, which takes frames without a checksum.
+   *    buffered
+   *      Boolean used to specify the stream buffers writes and reports availableForWrite().
    *  Returns True.
    */
-  bool begin(Stream& stream, bool variant) {
+  bool begin(Stream& stream, bool variant, bool buffered = false) {
     _serial = &stream;
     _variant = variant;
+    _buffered = buffered;
 
     sendStack.start_byte = dfplayer::SB;
     sendStack.version = dfplayer::VER;
@@ -67,23 +122,195 @@ class DFPlayerMini {
     recStack.length = dfplayer::LEN;
     recStack.end_byte = dfplayer::EB;
 
+    _txQueue.clear();
+    _txOffset = 0;
+    _txGap = 0;
+    _lastTxTime = millis();
+
     if (_variant) {
       reset();
-      delay(200);
     }
 
     return true;
   }
 
+  /**
+   *  Drains the transmit queue. This should be called in the main loop.
+   *  At most TX_BYTES_PER_UPDATE bytes are written per call, or what fits in
+   *  the buffer of a buffered port, and the next
+   *  frame is not started until the command gap of the previous one has passed.
+   *  Returns True while there are frames waiting to be sent.
+   */
+  bool update() {
+    PROFILE_SCOPE(easyprofile::MINI_TX);
+    readFrames();
+    if (_waitAck) {
+      if ((millis() - _lastTxTime) < dfplayer::ACK_TIMEOUT)
+        return true;
+      retryFrame(dfplayer::ERROR_NO_ACK);
+    }
+    if (_txQueue.isEmpty())
+      return false;
+
+    frame& f = _txQueue.front();
+    if (_txOffset == 0 && (millis() - _lastTxTime) < _txGap)
+      return true;
+
+    uint8_t room = dfplayer::TX_BYTES_PER_UPDATE;
+    if (_buffered) {
+      int free = _serial->availableForWrite();
+      room = free > dfplayer::STACK_SIZE ? dfplayer::STACK_SIZE : (free > 0 ? free : 0);
+    }
+    uint8_t count = 0;
+    while (_txOffset < f.length && count < room) {
+      _serial->write(f.data[_txOffset]);
+      _txOffset++;
+      count++;
+    }
+
+    if (_txOffset == f.length) {
+      _lastTxTime = millis();
+      _txGap = f.gap;
+      _txOffset = 0;
+      if (LOG_ON(AUDIO, DEBUG))
+        printFrame(f);
+      if (f.data[4] == dfplayer::FEEDBACK) {
+        _waitAck = true;
+        return true;
+      }
+      frameDone();
+    }
+    return !_txQueue.isEmpty();
+  }
+
+  /**
+   *  Ask the player to ACK each command, and send it again if the ACK does not come.
+   */
+  void setFeedback(bool feedback) {
+    _feedback = feedback;
+  }
+
+  /**
+   *  Set a callback that is called from update() with each reply and its param,
+   *  and with ERR when a command is given up or dropped.
+   */
+  void setCallback(reply_callback callback) {
+    _callback = callback;
+  }
+
+  /**
+   *  Returns False after the player has reported the card removed.
+   */
+  bool isCardOnline() {
+    return _cardOnline;
+  }
+
+  /**
+   *  Returns the last error value, 0 if there has been none.
+   */
+  uint8_t getLastError() {
+    return _lastError;
+  }
+
+  /**
+   *  Returns a running count of errors, wraps at 255.
+   */
+  uint8_t getErrorCount() {
+    return _errorCount;
+  }
+
+  /**
+   *  Returns a running count of commands replaced by a newer one while queued, wraps at 255.
+   */
+  uint8_t getMergedCount() {
+    return _mergedCount;
+  }
+
+  /**
+   *  Returns a running count of commands sent again, wraps at 255.
+   */
+  uint8_t getRetryCount() {
+    return _retryCount;
+  }
+
+  /**
+   *  Returns a running count of "track finished" frames received, wraps at 255.
+   *  The player sends each one twice.
+   */
+  uint8_t getFinishedCount() {
+    return _finishedCount;
+  }
+
+  /**
+   *  Returns the file number from the last "track finished" frame.
+   */
+  uint16_t getFinishedTrack() {
+    return _finishedTrack;
+  }
+
+  /**
+   *  Blocks until every queued frame has been sent and the last command gap has passed.
+   *  Only intended for setup code or sketches without a main loop.
+   */
+  void flush() {
+    while (update()) {}
+    while ((millis() - _lastTxTime) < _txGap) {}
+  }
+
+  /**
+   *  Extends the gap after the last queued frame, holding back whatever is queued after it.
+   *    ms
+   *      Minimum number of ms between the last queued frame and the next one.
+   */
+  void hold(uint16_t ms) {
+    if (!_txQueue.isEmpty()) {
+      frame& f = _txQueue.back();
+      if (f.gap < ms) f.gap = ms;
+    } else if (_txGap < ms) {
+      _txGap = ms;
+    }
+  }
+
+  /**
+   *  Keeps the frames queued so far as they are, a newer play or volume frame is
+   *  queued behind them instead of replacing one of them.
+   */
+  void keep() {
+    if (!_txQueue.isEmpty())
+      _txQueue.back().keep = true;
+  }
+
+  /**
+   *  Returns True when nothing is waiting to be sent.
+   */
+  bool isIdle() {
+    return _txQueue.isEmpty();
+  }
+
+  /**
+   *  Returns the number of frames waiting to be sent.
+   */
+  uint8_t pending() {
+    return _txQueue.size();
+  }
+
+  /**
+   *  Returns a running count of frames sent, wraps at 255.
+   */
+  uint8_t getSentCount() {
+    return _sentCount;
+  }
+
   /**
    *  Set the volume to a specific value out of 30.
    *  volume
    *    The volume level (0 - 30).
    */
   void volume(uint8_t volume) {
-    if (volume <= 30) {
+    if (volume <= 30 && volume != _volume) {
+      _volume = volume;
       sendStack.commandValue = dfplayer::VOLUME;
-      sendStack.feedbackValue = dfplayer::NO_FEEDBACK;
+      sendStack.feedbackValue = _feedback ? dfplayer::FEEDBACK : dfplayer::NO_FEEDBACK;
       sendStack.paramMSB = 0;
       sendStack.paramLSB = volume;
 
@@ -99,7 +326,7 @@ class DFPlayerMini {
    */
   void playFromMP3Folder(uint16_t trackNum) {
     sendStack.commandValue = dfplayer::USE_MP3_FOLDER;
-    sendStack.feedbackValue = dfplayer::NO_FEEDBACK;
+    sendStack.feedbackValue = _feedback ? dfplayer::FEEDBACK : dfplayer::NO_FEEDBACK;
     sendStack.paramMSB = (trackNum >> 8) & 0xFF;
     sendStack.paramLSB = trackNum & 0xFF;
 
@@ -107,14 +334,16 @@ class DFPlayerMini {
     sendData();
   }
 
+  // the player answers a reset with ONLINE, not an ACK
   void reset() {
+    _volume = 0xFF;
     sendStack.commandValue = dfplayer::RESET;
     sendStack.feedbackValue = dfplayer::NO_FEEDBACK;
     sendStack.paramMSB = 0;
     sendStack.paramLSB = 0;
 
     findChecksum(sendStack);
-    sendData();
+    sendData(dfplayer::RESET_GAP);
   }
 
 private:
@@ -134,8 +363,133 @@ class DFPlayerMini {
     uint8_t end_byte;
   } sendStack, recStack;
 
+  /**
+   * A command packet as it goes out on the wire, plus the time the player
+   * needs before it accepts the next command.
+   */
+  struct frame {
+    uint8_t data[dfplayer::STACK_SIZE];
+    uint8_t length;
+    uint16_t gap;
+    uint8_t retries;
+    bool keep;                       // never replaced by a newer frame, see keep()
+  };
+
   Stream* _serial;
   bool _variant;
+  bool _buffered = false;            // writes go into a buffer rather than blocking
+
+  EasyQueue<frame, dfplayer::QUEUE_SIZE> _txQueue;
+  uint8_t _txOffset = 0;             // next byte of the front frame to write
+  uint16_t _txGap = 0;               // gap required after the last frame sent
+  unsigned long _lastTxTime = 0;     // time the last frame finished sending
+  uint8_t _sentCount = 0;            // running count of frames sent
+  uint8_t _mergedCount = 0;          // running count of frames replaced while queued
+  uint8_t _volume = 0xFF;            // last volume requested, 0xFF when not known
+  bool _feedback = false;            // ask for an ACK to each command
+  bool _waitAck = false;             // the front frame is sent and waiting for its ACK
+  uint8_t _retryCount = 0;           // running count of frames sent again
+  uint8_t _rxCount = 0;              // bytes of recStack received so far
+  uint8_t _finishedCount = 0;        // running count of "track finished" frames
+  uint16_t _finishedTrack = 0;       // file number of the last finished track
+  bool _cardOnline = true;
+  uint8_t _lastError = 0;
+  uint8_t _errorCount = 0;           // running count of errors
+  reply_callback _callback = 0;
+
+  /**
+   *  Reads whatever bytes have arrived into recStack, a frame at a time.
+   *  A byte that can not be part of a frame starts the search for the next start byte.
+   */
+  void readFrames() {
+    uint8_t* raw = (uint8_t*)&recStack;
+    while (_serial->available()) {
+      uint8_t b = _serial->read();
+      if (_rxCount == 0 && b != dfplayer::SB) continue;
+      raw[_rxCount++] = b;
+      if ((_rxCount == 2 && b != dfplayer::VER) || (_rxCount == 3 && b != dfplayer::LEN)) {
+        _rxCount = 0;
+        if (b == dfplayer::SB) raw[_rxCount++] = b;
+        continue;
+      }
+      // the variant leaves out the checksum
+      if (_variant && _rxCount == dfplayer::STACK_SIZE - 2 && b == dfplayer::EB) {
+        _rxCount = 0;
+        handleReply();
+        continue;
+      }
+      if (_rxCount < dfplayer::STACK_SIZE) continue;
+      _rxCount = 0;
+      if (isValidReply())
+        handleReply();
+    }
+  }
+
+  bool isValidReply() {
+    if (recStack.end_byte != dfplayer::EB) return false;
+    stack check = recStack;
+    findChecksum(check);
+    return check.checksumMSB == recStack.checksumMSB && check.checksumLSB == recStack.checksumLSB;
+  }
+
+  void handleReply() {
+    uint16_t param = (recStack.paramMSB << 8) | recStack.paramLSB;
+    switch (recStack.commandValue) {
+      case dfplayer::ACK:
+        if (_waitAck) frameDone();
+        return;
+      case dfplayer::ERR:
+        if (_waitAck && (recStack.paramLSB == dfplayer::ERROR_BUSY || recStack.paramLSB == dfplayer::ERROR_SERIAL
+                         || recStack.paramLSB == dfplayer::ERROR_CHECKSUM)) {
+          retryFrame(recStack.paramLSB);
+          return;
+        }
+        if (_waitAck) frameDone();
+        commandFailed(recStack.paramLSB);
+        return;
+      case dfplayer::CARD_INSERTED:
+      case dfplayer::ONLINE:
+        _cardOnline = true;
+        break;
+      case dfplayer::CARD_REMOVED:
+        _cardOnline = false;
+        break;
+      case dfplayer::FINISHED_USB:
+      case dfplayer::FINISHED_SD:
+        _finishedTrack = param;
+        _finishedCount++;
+        break;
+    }
+    if (_callback) _callback(recStack.commandValue, param);
+  }
+
+  // the front frame is done with, sent or given up
+  void frameDone() {
+    _waitAck = false;
+    _sentCount++;
+    _txQueue.pop();
+  }
+
+  // send the front frame again, or give it up after MAX_RETRIES
+  void retryFrame(uint8_t error) {
+    frame& f = _txQueue.front();
+    _waitAck = false;
+    if (f.retries < dfplayer::MAX_RETRIES) {
+      f.retries++;
+      _retryCount++;
+      LOG(AUDIO, WARN, F("DFPlayer command sent again"));
+      return;
+    }
+    frameDone();
+    commandFailed(error);
+  }
+
+  void commandFailed(uint8_t error) {
+    _lastError = error;
+    _errorCount++;
+    LOG(AUDIO, ERROR, F("DFPlayer error: "), error, HEX);
+    if (_callback) _callback(dfplayer::ERR, error);
+  }
 
   /**
    *  Determine and insert the checksum of a given config/command packet into that same packet struct.
@@ -153,59 +507,77 @@ class DFPlayerMini {
 
 
   /**
-   *  Send a config/command packet to the MP3 player.
+   *  Returns the queued play or volume frame a new one of the same command can replace,
+   *  or NULL. The frame being sent is left alone, and so is anything before a hold or a keep.
    */
-  void sendData() {
-    _serial->write(sendStack.start_byte);
-    _serial->write(sendStack.version);
-    _serial->write(sendStack.length);
-    _serial->write(sendStack.commandValue);
-    _serial->write(sendStack.feedbackValue);
-    _serial->write(sendStack.paramMSB);
-    _serial->write(sendStack.paramLSB);
-    if (!_variant) {
-      _serial->write(sendStack.checksumMSB);
-      _serial->write(sendStack.checksumLSB);
+  frame* findQueued(uint8_t command) {
+    if (command != dfplayer::USE_MP3_FOLDER && command != dfplayer::VOLUME)
+      return NULL;
+    uint8_t first = (_txOffset > 0 || _waitAck) ? 1 : 0;
+    for (uint8_t i = _txQueue.size(); i > first; i--) {
+      frame& f = _txQueue.at(i - 1);
+      if (f.gap > dfplayer::COMMAND_GAP || f.keep) break;
+      if (f.data[3] == command) return &f;
+    }
+    return NULL;
+  }
+
+  /**
+   *  Queue a config/command packet to be sent to the MP3 player.
+   *    gap
+   *      Number of ms the player needs before it will accept the next command.
+   *  Returns False if the transmit queue is full and the packet was dropped.
+   */
+  bool sendData(uint16_t gap = dfplayer::COMMAND_GAP) {
+    PROFILE_SCOPE(easyprofile::MINI_SEND);
+    frame* f = findQueued(sendStack.commandValue);
+    if (f) {
+      _mergedCount++;
+      if (gap < f->gap) gap = f->gap;
+    } else {
+      f = _txQueue.pushSlot();
+    }
+    if (!f) {
+      LOG(AUDIO, WARN, F("DFPlayer queue full, command dropped"));
+      commandFailed(dfplayer::ERROR_QUEUE_FULL);
+      return false;
     }
-    _serial->write(sendStack.end_byte);
 
-    delay(30);
-#if ENABLE_DEBUG == 1
-    printStack(sendStack);
-#endif
+    uint8_t len = 0;
+    f->data[len++] = sendStack.start_byte;
+    f->data[len++] = sendStack.version;
+    f->data[len++] = sendStack.length;
+    f->data[len++] = sendStack.commandValue;
+    f->data[len++] = sendStack.feedbackValue;
+    f->data[len++] = sendStack.paramMSB;
+    f->data[len++] = sendStack.paramLSB;
+    if (!_variant) {
+      f->data[len++] = sendStack.checksumMSB;
+      f->data[len++] = sendStack.checksumLSB;
+    }
+    f->data[len++] = sendStack.end_byte;
+    f->length = len;
+    f->gap = gap;
+    f->retries = 0;
+    f->keep = false;
+    return true;
   }
 
 
   /**
-   *  Print the entire contents of the specified config/command packet for debugging purposes.
-   *    _stack
-   *        Struct containing the config/command packet to print.
-   */
-  void printStack(stack _stack) {
-    DBGLN(F("Sent Stack:"));
-    DBGHEX(_stack.start_byte);
-    DBGCH(' ');
-    DBGHEX(_stack.version);
-    DBGCH(' ');
-    DBGHEX(_stack.length);
-    DBGCH(' ');
-    DBGHEX(_stack.commandValue);
-    DBGCH(' ');
-    DBGHEX(_stack.feedbackValue);
-    DBGCH(' ');
-    DBGHEX(_stack.paramMSB);
-    DBGCH(' ');
-    DBGHEX(_stack.paramLSB);
-    DBGCH(' ');
-    if (!_variant) {
-      DBGHEX(_stack.checksumMSB);
-      DBGCH(' ');
-      DBGHEX(_stack.checksumLSB);
-      DBGCH(' ');
+   *  Log the entire contents of the specified config/command frame for debugging purposes.
+   *    _frame
+   *        Frame containing the config/command packet to print.
+   */
+  void printFrame(const frame& _frame) {
+#if ENABLE_DEBUG == 1
+    debugLog.print(F("Sent Stack: "));
+    for (uint8_t i = 0; i < _frame.length; i++) {
+      debugLog.print(_frame.data[i], HEX);
+      debugLog.print(' ');
     }
-    DBGHEX(_stack.end_byte);
-    DBGLN(F(""));
-    DBGLN(F(""));
+    debugLog.println();
+#endif
   }
 };
 #endif
@@ -2,13 +2,69 @@
 #define dfplayerpro_h
 
 #include <Arduino.h>
+#include "easyqueue.h"
 
 static const char CMD_OK[] PROGMEM =              {"OK\r\n"};
-static const char CMD_ERROR[] PROGMEM =           {"error"};
+
+/**
+ *  Namespace for constants
+ */
+namespace dfplayerpro {
+/** Command Queue */
+const uint8_t QUEUE_SIZE = 8;            // number of AT commands that can be waiting to be sent
+const uint16_t ACK_TIMEOUT = 1000;       // ms to wait for the reply to a command
+const uint16_t COMMAND_GAP = 30;         // ms the player needs between two commands
+const uint16_t MUSIC_MODE_GAP = 2000;    // ms the player needs to switch into music mode
+
+/** AT Commands */
+const uint8_t CMD_AT          = 0;
+const uint8_t CMD_AMP_ON      = 1;
+const uint8_t CMD_MUSIC_MODE  = 2;
+const uint8_t CMD_SINGLE_PLAY = 3;
+const uint8_t CMD_VOLUME      = 4;
+const uint8_t CMD_PLAYNUM     = 5;
+const uint8_t CMD_TOTAL_TIME  = 6;
+
+/** Command Status */
+const uint8_t STATUS_PENDING  = 0;       // queued or waiting for the reply
+const uint8_t STATUS_OK       = 1;       // player replied "OK"
+const uint8_t STATUS_ERROR    = 2;       // player replied with anything else
+const uint8_t STATUS_TIMEOUT  = 3;       // no reply within ACK_TIMEOUT
+const uint8_t STATUS_DROPPED  = 4;       // the queue was full, command never sent
+}
+
+static const char AT_CMD_AT[] PROGMEM =           {"AT"};
+static const char AT_CMD_AMP_ON[] PROGMEM =       {"AT+AMP=ON"};
+static const char AT_CMD_MUSIC_MODE[] PROGMEM =   {"AT+FUNCTION=1"};
+static const char AT_CMD_SINGLE_PLAY[] PROGMEM =  {"AT+PLAYMODE=3"};
+static const char AT_CMD_VOLUME[] PROGMEM =       {"AT+VOL="};
+static const char AT_CMD_PLAYNUM[] PROGMEM =      {"AT+PLAYNUM="};
+static const char AT_CMD_TOTAL_TIME[] PROGMEM =   {"AT+QUERY=4"};
+
+static const char* const AT_COMMANDS[] PROGMEM = {
+  AT_CMD_AT, AT_CMD_AMP_ON, AT_CMD_MUSIC_MODE, AT_CMD_SINGLE_PLAY, AT_CMD_VOLUME, AT_CMD_PLAYNUM,
+  AT_CMD_TOTAL_TIME
+};
+
+typedef void (*ack_callback)(uint8_t command, uint8_t status); // called when a command completes
 
 /**
  * Define the basic structure of class DF Player Pro DF1201S, the implementation of basic methods.
  * This module is a conversion board, which can drive DF1201S DFPlayer PRO MP3 through I2C
+ *
+ * None of the methods block. Each AT command is added to a queue and the call
+ * returns straight away. The poll() function should be called in the main loop;
+ * it sends the next command, parses the "OK\r\n" or error reply a byte at a time,
+ * and waits out the gap the player needs before the next command. Queries are
+ * answered with a number instead of "OK", see getTotalTime().
+ *
+ * A play, volume or length query replaces a queued command of the same kind, so
+ * only the newest is sent. The one it replaces completes as STATUS_DROPPED. A
+ * volume that matches the last one requested is not sent at all.
+ *
+ * Completion is reported through lastStatus(), or a callback:
+ * eg. player.setCallback(onPlayerAck);
+ *     void onPlayerAck(uint8_t command, uint8_t status) { ... }
  */
 class DFPlayerPro {
 public:
@@ -20,178 +76,352 @@ class DFPlayerPro {
   /**
    * init function
    *   s serial
-   * Returns Boolean type, Indicates the initialization result
-   *   true The setting succeeded
-   *   false Setting failed
+   * Returns Boolean type, Indicates the handshake was queued
+   *   true The command was queued, the result is reported when it completes
+   *   false The queue is full
    */
   bool begin(Stream& s) {
     _s = &s;
-    writeATCommand(F("AT\r\n"));
-    return readAck();
+    _queue.clear();
+    _state = STATE_IDLE;
+    _volume = -1;
+    return queueCommand(dfplayerpro::CMD_AT, 0, true);
   }
 
+  /**
+   * Set a callback that is called with the command and status as each command completes.
+   */
+  void setCallback(ack_callback callback) {
+    _callback = callback;
+  }
 
   /**
-   * Set volume 
+   * Set volume
    *   vol 0-30
-   * Returns Boolean type, the result of seted
-   *   true The setting succeeded
-   *   false Setting failed
+   * Returns Boolean type, the command was queued
   */
   bool setVolume(uint8_t vol) {
-    char data[10];
-    memset(data, '\0', sizeof(char)*10);
-    itoa(vol, data, 10);
-
-    drain();
-    writeBuffer(F("AT+VOL="));
-    writeBuffer(data);
-    writeBuffer(F("\r\n"));
-    delay(30);
-
-    return readAck();
+    if (vol == _volume) return true;
+    _volume = vol;
+    return queueCommand(dfplayerpro::CMD_VOLUME, vol, true);
   }
 
   /**
-   * Set working mode 
-   *   function MUSIC=1,RECORD=2,UFDISK=3
-   * Returns Boolean type, the result of seted
-   *   true The setting succeeded
-   *   false Setting failed
+   * Set working mode to music. The player needs a couple of seconds before
+   * it accepts the next command; the queue holds until then.
+   * Returns Boolean type, the command was queued
    */
   bool musicMode() {
-    writeATCommand(F("AT+FUNCTION=1\r\n"));
-    if (readAck()) {
-      delay(2000);
-      return true;
-    }
-    return false;
+    return queueCommand(dfplayerpro::CMD_MUSIC_MODE, 0, true);
   }
 
   /**
-   * Set playback mode 
-   *   mode SINGLECYCLE=1,ALLCYCLE=2,SINGLE=3,RANDOM=4,FOLDER=5
-   * Returns Boolean type, the result of seted
-   *   true The setting succeeded
-   *   false Setting failed
+   * Set playback mode to play a single track and pause
+   * Returns Boolean type, the command was queued
    */
   bool singlePlayMode() {
-    writeATCommand(F("AT+PLAYMODE=3\r\n"));
-    return readAck();
+    return queueCommand(dfplayerpro::CMD_SINGLE_PLAY, 0, true);
   }
 
   /**
    * Enable Amplifier chip
-   * Returns Boolean type, the result of operation
-   *   true The setting succeeded
-   *   false Setting failed
+   * Returns Boolean type, the command was queued
    */
   bool enableAMP() {
-    writeATCommand(F("AT+AMP=ON\r\n"));
-    return readAck();
+    return queueCommand(dfplayerpro::CMD_AMP_ON, 0, true);
   }
 
   /**
    * Play the file of specific number, the numbers are arranged according to the
    * sequence the files are copied onto the U-disk.
-   *   num file number, can be obtained by getCurFileNumber()
-   * Returns Boolean type, the result of operation
-   *   true The setting succeeded
-   *   false Setting failed
+   *   num file number
+   *   waitReply hold the queue until the player replies
+   * Returns Boolean type, the command was queued
    */
   bool playFileNum(int16_t num, bool waitReply=false) {
-    char data[10];
-    memset(data, '\0', sizeof(char)*10);
-    itoa(num, data, 10);
+    return queueCommand(dfplayerpro::CMD_PLAYNUM, num, waitReply);
+  }
 
-    drain();
-    writeBuffer(F("AT+PLAYNUM="));
-    writeBuffer(data);
-    writeBuffer(F("\r\n"));
-    delay(30);
-    if (waitReply)
-      return readAck();      
-    return true;
+  /**
+   * Ask for the length of the current track, the reply is read from getTotalTime().
+   * Returns Boolean type, the command was queued
+   */
+  bool queryTotalTime() {
+    _totalTime = -1;
+    return queueCommand(dfplayerpro::CMD_TOTAL_TIME, 0, true);
   }
 
-private:
-  Stream* _s = NULL;
+  /**
+   * Returns the length of the current track in seconds, from the last queryTotalTime().
+   * Returns -1 until the reply arrives.
+   */
+  int16_t getTotalTime() {
+    return _totalTime;
+  }
 
-  void drain() {
-    //DBGLN(F("Drain buffer"));
-    while (_s->available()) {
-      _s->read();
+  /**
+   * Returns the file number the last length query was about, the last one played
+   * before the query was sent.
+   */
+  int16_t getTotalTimeFile() {
+    return _totalTimeFile;
+  }
+
+  /**
+   * Returns a running count of length queries that timed out, failed or were
+   * dropped, wraps at 255. getTotalTimeFile() is the file of the last one.
+   */
+  uint8_t getLengthFailedCount() {
+    return _lengthFailedCount;
+  }
+
+  /**
+   * Runs the command state machine. This should be called in the main loop.
+   * Returns True while commands are queued or in flight.
+   */
+  bool poll() {
+    if (!_s) return false;
+
+    switch (_state) {
+      case STATE_WAIT_ACK:
+        readAck();
+        break;
+      case STATE_HOLD:
+        if ((millis() - _stateTime) >= _holdTime)
+          _state = STATE_IDLE;
+        break;
+      default:
+        if (!_queue.isEmpty())
+          sendNext();
+        else
+          drain();
+        break;
     }
+    return !isIdle();
   }
 
-  void writeBuffer(const __FlashStringHelper* buffer) {
-    DBGLN(buffer);
-    _s->print(buffer);
+  /**
+   * Blocks until every queued command has completed.
+   * Only intended for setup code or sketches without a main loop.
+   */
+  void flush() {
+    while (poll()) {}
   }
 
-  void writeATCommand(const __FlashStringHelper* command) {
-    DBGSTR(F("COMMAND: "));
-    DBGLN(command);
-    drain();
-    _s->print(command);
-    delay(30);
+  /**
+   * Keeps the commands queued so far as they are, a newer play, volume or query
+   * is queued behind them instead of replacing one of them.
+   */
+  void keep() {
+    if (!_queue.isEmpty())
+      _queue.back().keep = true;
+  }
+
+  /**
+   * Returns True when nothing is queued or in flight.
+   */
+  bool isIdle() {
+    return _state == STATE_IDLE && _queue.isEmpty();
   }
 
-  void writeBuffer(const char* buffer) {
-    DBGLOG(buffer);
-    _s->write(buffer);
+  /**
+   * Returns the number of commands queued or in flight.
+   */
+  uint8_t pending() {
+    return _queue.size() + (_state == STATE_WAIT_ACK ? 1 : 0);
+  }
+
+  /**
+   * Returns a running count of commands completed, wraps at 255.
+   */
+  uint8_t getSentCount() {
+    return _sentCount;
+  }
+
+  /**
+   * Returns a running count of commands replaced by a newer one while queued, wraps at 255.
+   */
+  uint8_t getMergedCount() {
+    return _mergedCount;
+  }
+
+  /**
+   * Returns the status of the last command that completed.
+   */
+  uint8_t lastStatus() {
+    return _lastStatus;
   }
 
+private:
+  static const uint8_t STATE_IDLE     = 0;
+  static const uint8_t STATE_WAIT_ACK = 1;
+  static const uint8_t STATE_HOLD     = 2;
+
+  /**
+   * A queued command, the text is looked up in AT_COMMANDS when it is sent.
+   */
+  struct command {
+    uint8_t id;
+    int16_t param;
+    bool waitReply;
+    bool keep;                       // never replaced by a newer command, see keep()
+  };
+
+  Stream* _s = NULL;
+  ack_callback _callback = 0;
+  EasyQueue<command, dfplayerpro::QUEUE_SIZE> _queue;
 
-  bool readAck() {
-    char buf[30];
-    char* response = read(buf, 4);
-    DBGSTR(F("RESPONSE: "));
-    DBGLOG(response);
+  uint8_t _state = STATE_IDLE;
+  uint8_t _current = 0;              // command in flight
+  uint8_t _lastStatus = dfplayerpro::STATUS_PENDING;
+  unsigned long _stateTime = 0;      // time the current state was entered
+  uint16_t _holdTime = 0;            // gap before the next command
+  uint8_t _rxCount = 0;              // bytes received for the current reply
+  bool _rxMatch = true;              // reply matches "OK\r\n" so far
+  int16_t _rxValue = -1;             // number in the reply so far, -1 if it is not a number
+  int16_t _totalTime = -1;           // reply to the last total time query
+  int16_t _totalTimeFile = 0;        // file the last query was about
+  uint8_t _lengthFailedCount = 0;    // running count of length queries without a reply
+  int16_t _playedFile = 0;           // file of the last play sent
+  uint8_t _sentCount = 0;            // running count of commands completed
+  uint8_t _mergedCount = 0;          // running count of commands replaced while queued
+  int16_t _volume = -1;              // last volume requested, -1 when not known
 
-     if (strcmp_P(response, CMD_OK) == 0) {
+  bool queueCommand(uint8_t id, int16_t param, bool waitReply) {
+    command* queued = findQueued(id);
+    if (queued) {
+      _mergedCount++;
+      if (_callback) _callback(id, dfplayerpro::STATUS_DROPPED);
+      queued->param = param;
+      queued->waitReply |= waitReply;
       return true;
     }
+    command cmd = { id, param, waitReply, false };
+    if (!_queue.push(cmd)) {
+      LOG(AUDIO, WARN, F("DFPlayer queue full, command dropped"));
+      complete(id, dfplayerpro::STATUS_DROPPED);
+      return false;
+    }
+    return true;
+  }
+
+  // a queued play, volume or query that a new one of the same kind can replace
+  command* findQueued(uint8_t id) {
+    if (id != dfplayerpro::CMD_PLAYNUM && id != dfplayerpro::CMD_VOLUME && id != dfplayerpro::CMD_TOTAL_TIME)
+      return NULL;
+    for (uint8_t i = _queue.size(); i > 0; i--) {
+      command& cmd = _queue.at(i - 1);
+      if (cmd.keep) break;
+      if (cmd.id == id) return &cmd;
+      // a length query belongs to the play before it
+      if (id == dfplayerpro::CMD_TOTAL_TIME && cmd.id == dfplayerpro::CMD_PLAYNUM) break;
+    }
+    return NULL;
+  }
+
+  bool isQueued(uint8_t id) {
+    for (uint8_t i = 0; i < _queue.size(); i++) {
+      if (_queue.at(i).id == id) return true;
+    }
     return false;
   }
 
-  char* read(char* buffer, uint8_t len) {
-    size_t offset = 0, left = len;
-    memset(buffer, '\0', sizeof(char)*30);
-    long curr = millis();
-    if (len == 0) {
-      while (1) {
-        if (_s->available()) {
-          buffer[offset] = (char)_s->read();
-          offset++;
-        }
-        if ((buffer[offset - 1]) == '\n' && (buffer[offset - 2] == '\r')) break;
-        if (millis() - curr > 1000) {
-          return getString_P(buffer, CMD_ERROR, 6);
-        }
-      }
-    } else {
-      while (left) {
-        if (_s->available()) {
-          buffer[offset] = (char)_s->read();
-          left--;
-          offset++;
-        }
-        if (buffer[offset - 1] == '\n' && buffer[offset - 2] == '\r') break;
-        if (millis() - curr > 1000) {
-          return getString_P(buffer, CMD_ERROR, 6);
+  void drain() {
+    while (_s->available()) {
+      _s->read();
+    }
+  }
+
+  void sendNext() {
+    PROFILE_SCOPE(easyprofile::PRO_SEND);
+    command& cmd = _queue.front();
+    if (cmd.id == dfplayerpro::CMD_TOTAL_TIME && isQueued(dfplayerpro::CMD_PLAYNUM)) {
+      // the track it asks about is about to be replaced, don't spend the serial time
+      _queue.pop();
+      _sentCount++;
+      _mergedCount++;
+      lengthFailed();
+      if (_callback) _callback(dfplayerpro::CMD_TOTAL_TIME, dfplayerpro::STATUS_DROPPED);
+      return;
+    }
+    const __FlashStringHelper* text = (const __FlashStringHelper*)pgm_read_ptr(&AT_COMMANDS[cmd.id]);
+
+    drain();
+    LOG(AUDIO, DEBUG, F("COMMAND: "), text);
+    _s->print(text);
+    if (cmd.id == dfplayerpro::CMD_VOLUME || cmd.id == dfplayerpro::CMD_PLAYNUM)
+      _s->print(cmd.param);
+    _s->print(F("\r\n"));
+
+    _current = cmd.id;
+    if (cmd.id == dfplayerpro::CMD_PLAYNUM)
+      _playedFile = cmd.param;
+    _stateTime = millis();
+    _rxCount = 0;
+    _rxMatch = true;
+    _rxValue = 0;
+    _lastStatus = dfplayerpro::STATUS_PENDING;
+    if (cmd.waitReply)
+      _state = STATE_WAIT_ACK;
+    else
+      finish(dfplayerpro::STATUS_OK);
+    _queue.pop();
+  }
+
+  /**
+   * Consume whatever reply bytes have arrived, comparing them against "OK\r\n"
+   * as they come in. A query reply is a number. Any other line is treated as an error.
+   */
+  void readAck() {
+    PROFILE_SCOPE(easyprofile::PRO_ACK);
+    while (_s->available()) {
+      char ch = (char)_s->read();
+      if (_rxCount >= sizeof(CMD_OK) - 1 || ch != (char)pgm_read_byte(&CMD_OK[_rxCount]))
+        _rxMatch = false;
+      if (ch >= '0' && ch <= '9' && _rxValue >= 0 && _rxValue < 3000)
+        _rxValue = _rxValue * 10 + (ch - '0');
+      else if (ch != '\r' && ch != '\n')
+        _rxValue = -1;
+      _rxCount++;
+      if (ch == '\n') {
+        bool isValue = _current == dfplayerpro::CMD_TOTAL_TIME && _rxValue >= 0 && _rxCount > 2;
+        if (isValue) {
+          _totalTime = _rxValue;
+          _totalTimeFile = _playedFile;
         }
+        finish(_rxMatch || isValue ? dfplayerpro::STATUS_OK : dfplayerpro::STATUS_ERROR);
+        return;
       }
-      buffer[len] = 0;
     }
-    return buffer;
+    if ((millis() - _stateTime) > dfplayerpro::ACK_TIMEOUT)
+      finish(dfplayerpro::STATUS_TIMEOUT);
+  }
+
+  void finish(uint8_t status) {
+    _holdTime = dfplayerpro::COMMAND_GAP;
+    if (_current == dfplayerpro::CMD_MUSIC_MODE && status == dfplayerpro::STATUS_OK)
+      _holdTime = dfplayerpro::MUSIC_MODE_GAP;
+    _state = STATE_HOLD;
+    _stateTime = millis();
+    _sentCount++;
+    if (_current == dfplayerpro::CMD_TOTAL_TIME && status != dfplayerpro::STATUS_OK)
+      lengthFailed();
+    complete(_current, status);
   }
 
-  char* getString_P(char* txtbuf, const char* str, uint8_t len) {
-    memset(txtbuf, '\0', sizeof(char)*30);
-    strncpy_P(txtbuf, str, len);
-    return txtbuf;
+  // the query was about the file played before it, which has been sent
+  void lengthFailed() {
+    _totalTime = -1;
+    _totalTimeFile = _playedFile;
+    _lengthFailedCount++;
   }
 
+  void complete(uint8_t id, uint8_t status) {
+    _lastStatus = status;
+    if (status == dfplayerpro::STATUS_ERROR || status == dfplayerpro::STATUS_TIMEOUT) {
+      LOG(AUDIO, ERROR, F("RESPONSE: "), F("error"));
+    }
+    if (_callback) _callback(id, status);
+  }
 };
 #endif
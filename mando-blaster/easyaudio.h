@@ -3,19 +3,38 @@
 
 #define MINI_BAUD_RATE 9600
 #define PRO_BAUD_RATE 115200
+#define POWER_ON_DELAY 1000   // ms the player needs after power on before it accepts commands
+#define BUSY_START_TIME 300   // ms for the BUSY pin to go LOW after a play command
+#define FINISHED_GUARD 100    // ms after a play command to ignore "track finished" replies
+#define TRACK_REPEAT_GAP 50   // ms, the same track played again sooner than this is dropped, DF players only
+#define TRACK_LENGTHS 16      // tracks whose length the DF Pro keeps, from track 1
 
+#if ENABLE_EASY_AUDIO_PCM == 1
+#include "easymixer.h"
+#include "pcm_sounds.h"
+#else
+#if AUDIO_SERIAL == AUDIO_SERIAL_ALT
+#include <AltSoftSerial.h>
+#elif AUDIO_SERIAL == AUDIO_SERIAL_SOFTWARE
 #include <SoftwareSerial.h>
+#endif
 #if ENABLE_EASY_AUDIO_PRO == 1
 #include "dfplayer_pro.h"
 #else
 #include "dfplayer_mini.h"
 #endif
+#endif
 
 /**
  * EasyAudio is based on DF Player components that provide simple setup and easy track playback.
  * 
  * Constructor takes rx and tx pins as inputs, but will default to 0 and 1.
  * eg: EasyAudio audio(0, 1);
+ *
+ * The serial port is picked with AUDIO_SERIAL in config.h. The pins are only used
+ * by SoftwareSerial; the hardware UART and AltSoftSerial have fixed pins. Both of
+ * those buffer what is written and send it from an interrupt, so a play command
+ * costs tens of us instead of ~10ms with interrupts off.
  * 
  * Call the begin function to initialize the serial comms, and set the volume.
  * Volume range is 0 - 30, default is 25.
@@ -25,27 +44,108 @@
  * the files are loaded/copied onto the SD card.
  * eg. audio.playTrackNow(1);
  * 
- * When using in main loop, better to queue tracks for playback and eliminate using delays.
- * eg. audio.queuePlayback(1);
- * 
- * In the main loop, playback the next queued track:
- * eg. audio.playQueuedTrack();
+ * Playback requests are queued and returned from immediately, so they are safe
+ * to call from the main loop. The queue is sent to the player a few bytes at a
+ * time by calling update(), which should be added to the main loop:
+ * eg. audio.update();
+ *
+ * Start up does not block either. begin() queues the player configuration and
+ * update() steps through the boot phases:
+ *   AUDIO_BOOT_POWER_ON - waiting for the player to power up
+ *   AUDIO_BOOT_CONFIG   - configuration commands are being sent
+ *   AUDIO_BOOT_READY    - configuration is done
+ * Tracks played before the player is ready are queued behind the configuration.
+ *
+ * The DF Mini's replies are checked too. Errors, eg. a missing track, are logged,
+ * and with ENABLE_EASY_AUDIO_ACK each command is ACKed and sent again if it is lost.
+ *
+ * Only commands that change what is heard use the serial line. A track requested
+ * while another play is still queued replaces it, unless keepQueue() was called after it, the same track played again
+ * within TRACK_REPEAT_GAP is dropped, and an unchanged volume is not sent. The
+ * PCM mixer has no serial line, and overlaps the same effect played again.
+ *
+ * With ENABLE_EASY_AUDIO_PCM the DF player is replaced by an EasyMixer. The tracks
+ * are short effects in pcm_sounds.h, tracks without an effect are skipped. Effects
+ * start within a sample period and overlap rather than cut each other off. There
+ * is no boot delay.
+ *
+ * Playback state comes from the player, from the first of these that is available:
+ *   PCM mixer        - the mixer knows when each effect ends
+ *   AUDIO_BUSY_PIN   - the DF Mini BUSY output, when it is wired
+ *   DF Mini replies  - the "track finished" frame the Mini sends on its TX line
+ *   DF Pro query     - the length of a track is asked for the first time it plays,
+ *                      and kept for the first TRACK_LENGTHS tracks
+ * When the player will not report the end of a track, it counts as playing for
+ * the busy delay passed to playTrack(), 100ms by default. That is until the Mini
+ * has sent its first "track finished" frame, after the Mini replies with an
+ * error, eg. a missing track, and when the Pro's length query fails or is dropped.
+ * eg. if (!audio.isPlaying(AUDIO_TRACK_THEME)) audio.playTrack(AUDIO_TRACK_THEME);
+ *     audio.onTrackFinished(themeFinished);
  */
+
+typedef void (*track_callback)(int track);  // called with the track that finished
+
 class EasyAudio {
 private:
+#if ENABLE_EASY_AUDIO_PCM == 1
+  EasyMixer _player;
+#else
+#if AUDIO_SERIAL == AUDIO_SERIAL_HARDWARE
+  HardwareSerial& _mySerial;
+#elif AUDIO_SERIAL == AUDIO_SERIAL_ALT
+  AltSoftSerial _mySerial;
+#else
   SoftwareSerial _mySerial;
+#endif
 #if ENABLE_EASY_AUDIO_PRO == 1
   DFPlayerPro _player;
 #else
   DFPlayerMini _player; // set to true if you have a chip variant of the DF PlayerMini
+#endif
 #endif
 
   unsigned long _lastPlaybackTime = 0;
   long _playbackDelay = 100;
 
+  // playback state
+  int _track = 0;                    // last track played
+  bool _playing = false;
+  bool _feedback = false;            // the player will report the end of the current track
+  uint8_t _failedCount = 0;          // errors on the Mini, failed length queries on the Pro, when the track was played
+#if ENABLE_EASY_AUDIO_PRO == 0 && ENABLE_EASY_AUDIO_PCM == 0
+  bool _reportsEnd = false;          // the Mini has sent a "track finished" frame
+#endif
+  bool _busySeen = false;            // BUSY went LOW for the current track
+  unsigned long _trackLength = 0;    // ms, 0 when not known
+#if ENABLE_EASY_AUDIO_PRO == 1
+  uint8_t _trackSeconds[TRACK_LENGTHS] = {0};   // length + 1 of each track in secs, 0 when not known
+#endif
+  uint8_t _finishedCount = 0;        // finished count of the player when last checked
+  track_callback _finishedCallback = 0;
+
+  uint8_t _bootPhase = 0;
+  unsigned long _bootTime = 0;       // time begin() was called
+  unsigned long _readyTime = 0;      // time the player finished configuration
+  uint8_t _configCount = 0;          // sent count of the player once configuration is done
+
 public:
+  static const uint8_t AUDIO_BOOT_POWER_ON = 0;
+  static const uint8_t AUDIO_BOOT_CONFIG   = 1;
+  static const uint8_t AUDIO_BOOT_READY    = 2;
+
+#if ENABLE_EASY_AUDIO_PCM == 1
+  // the mixer always outputs on PCM_AUDIO_PIN
+  EasyAudio(uint8_t rxPin, uint8_t txPin) {};
+#elif AUDIO_SERIAL == AUDIO_SERIAL_HARDWARE
+  EasyAudio(uint8_t rxPin, uint8_t txPin)
+    : _mySerial(Serial){};
+#elif AUDIO_SERIAL == AUDIO_SERIAL_ALT
+  // AltSoftSerial always uses pins 8 and 9
+  EasyAudio(uint8_t rxPin, uint8_t txPin) {};
+#else
   EasyAudio(uint8_t rxPin, uint8_t txPin)
     : _mySerial(rxPin, txPin){};
+#endif
 
   bool begin(uint8_t vol) {
 #if ENABLE_EASY_AUDIO_MINI_VAR == 1
@@ -54,12 +154,20 @@ class EasyAudio {
     bool variant = false;
 #endif //ENABLE_EASY_AUDIO_MINI_VAR
 
+    _bootPhase = AUDIO_BOOT_POWER_ON;
+    _bootTime = millis();
 #if ENABLE_EASY_AUDIO == 1
-    DBGLN(F("setup audio"));
-#if ENABLE_EASY_AUDIO_PRO == 1
+    LOG(AUDIO, INFO, F("setup audio"));
+#if ENABLE_EASY_AUDIO_PCM == 1
+    _player.begin();
+    _player.setMasterVolume(vol >= 30 ? 255 : vol * 255 / 30);
+    _bootPhase = AUDIO_BOOT_READY;
+    _readyTime = millis();
+#elif ENABLE_EASY_AUDIO_PRO == 1
     _mySerial.begin(PRO_BAUD_RATE);
+    // commands are queued and sent from update(), failures are reported as they complete
     if (!_player.begin(_mySerial)) {
-      DBGLN(F("DFPlayer failed"));
+      LOG(AUDIO, ERROR, F("DFPlayer failed"));
       return false;
     }
     _player.enableAMP();       // Enable amplifier chip
@@ -68,24 +176,138 @@ class EasyAudio {
     _player.setVolume(vol);    // initial volume, 30 is max, 25 makes the wife not angry
 #else
     _mySerial.begin(MINI_BAUD_RATE);
-    _player.begin(_mySerial, variant);  //set Serial for DFPlayer-mini mp3 module
+    // only the hardware UART reports the room in its buffer
+    _player.begin(_mySerial, variant, AUDIO_SERIAL == AUDIO_SERIAL_HARDWARE);
+    _player.setFeedback(ENABLE_EASY_AUDIO_ACK == 1);
+    _player.setCallback(onPlayerReply);
     _player.volume(vol);                //initial volume, 30 is max, 3 makes the wife not angry
-#endif // ENABLE_EASY_AUDIO_PRO
-    delay(1000);
+#endif // ENABLE_EASY_AUDIO_PCM
+#if ENABLE_EASY_AUDIO_PCM == 0
+    _configCount = _player.getSentCount() + _player.pending();
+#endif
+#else
+    _bootPhase = AUDIO_BOOT_READY;
 #endif // ENABLE_EASY_AUDIO
     return true;
   }
 
   /**
-   * Poor version of checking playback instead of adding delays.
-   * THe proper solution would be to check whether the component is busy.
-   * Our wiring doesn't support it at the moment
+   * Sends any queued commands to the player. This should be called in the main loop.
+   * Returns True while there are commands waiting to be sent.
    */
-  bool isBusy() {
-    if (millis() > (_lastPlaybackTime + _playbackDelay)) {
-        return false;
+  bool update() {
+#if ENABLE_EASY_AUDIO == 1 && ENABLE_EASY_AUDIO_PCM == 0
+    if (_bootPhase == AUDIO_BOOT_POWER_ON) {
+      if ((millis() - _bootTime) < POWER_ON_DELAY)
+        return true;
+      _bootPhase = AUDIO_BOOT_CONFIG;
     }
-    return true;
+  #if ENABLE_EASY_AUDIO_PRO == 1
+    bool pending = _player.poll();
+  #else
+    bool pending = _player.update();
+  #endif
+    updatePlayback();
+    if (_bootPhase == AUDIO_BOOT_CONFIG && (uint8_t)(_player.getSentCount() - _configCount) < 128) {
+      _bootPhase = AUDIO_BOOT_READY;
+      _readyTime = millis();
+      LOG(AUDIO, INFO, F("Audio ready (ms): "), _readyTime);
+    }
+    return pending;
+#elif ENABLE_EASY_AUDIO == 1
+    _player.update();
+    updatePlayback();
+#endif
+    return false;
+  }
+
+  /**
+   * Returns True once the player has powered up and been configured.
+   */
+  bool isReady() {
+    return _bootPhase == AUDIO_BOOT_READY;
+  }
+
+  /**
+   * Returns the current boot phase, see AUDIO_BOOT_*.
+   */
+  uint8_t getBootPhase() {
+    return _bootPhase;
+  }
+
+  /**
+   * Returns the time, in ms since power on, the player became ready. 0 until then.
+   */
+  unsigned long getReadyTime() {
+    return _readyTime;
+  }
+
+  /**
+   * Holds back the next queued command for the given number of ms after the
+   * last queued one has been sent. Only needed by the DF Mini.
+   */
+  void holdQueue(uint16_t ms) {
+#if ENABLE_EASY_AUDIO == 1 && ENABLE_EASY_AUDIO_PRO == 0 && ENABLE_EASY_AUDIO_PCM == 0
+    _player.hold(ms);
+#endif
+  }
+
+  /**
+   * Keeps the tracks queued so far, a track played later is sent after them
+   * rather than in place of them. eg. the start up track, queued before the
+   * player is ready, is not lost to a shot fired while the player boots.
+   */
+  void keepQueue() {
+#if ENABLE_EASY_AUDIO == 1 && ENABLE_EASY_AUDIO_PCM == 0
+    _player.keep();
+#endif
+  }
+
+  /**
+   * Returns True while a track is playing, see isPlaying().
+   */
+  bool isBusy() {
+    return isPlaying();
+  }
+
+  /**
+   * Returns True while a track is playing.
+   */
+  bool isPlaying() {
+#if ENABLE_EASY_AUDIO == 1 && ENABLE_EASY_AUDIO_PCM == 1
+    return _player.isPlaying();
+#else
+    return _playing;
+#endif
+  }
+
+  /**
+   * Returns True while the given track is playing.
+   */
+  bool isPlaying(int track) {
+    return _track == track && isPlaying();
+  }
+
+  /**
+   * Returns the ms since the current track started, 0 when nothing is playing.
+   */
+  unsigned long getPosition() {
+    return isPlaying() ? millis() - _lastPlaybackTime : 0;
+  }
+
+  /**
+   * Returns the length of the current track in ms, 0 when it is not known.
+   * Only the DF Pro reports it, a track under a second counts as its busy delay.
+   */
+  unsigned long getTrackLength() {
+    return _trackLength;
+  }
+
+  /**
+   * Set a callback that is called from update() with the track number when a track finishes.
+   */
+  void onTrackFinished(track_callback callback) {
+    _finishedCallback = callback;
   }
 
   /**
@@ -99,12 +321,26 @@ class EasyAudio {
    * play a track by number, with a specific busy delay
    */
   void playTrack(int track, long busyDelay) {
+#if ENABLE_EASY_AUDIO_PCM == 0
+    if (track == _track && _lastPlaybackTime && (millis() - _lastPlaybackTime) < TRACK_REPEAT_GAP)
+      return;
+#endif
     _playbackDelay = busyDelay;    
     _lastPlaybackTime = millis();
+    _track = track;
+    _playing = true;
+    _busySeen = false;
+    _trackLength = 0;
 #if ENABLE_EASY_AUDIO == 1
-  #if ENABLE_EASY_AUDIO_PRO == 1
+  #if ENABLE_EASY_AUDIO_PCM == 1
+    playSound(track);
+  #elif ENABLE_EASY_AUDIO_PRO == 1
+    _failedCount = _player.getLengthFailedCount();
     _player.playFileNum(track);
+    _feedback = getSavedLength(track) || _player.queryTotalTime();
   #else
+    _failedCount = _player.getErrorCount();
+    _feedback = _reportsEnd;
     _player.playFromMP3Folder(track);
   #endif
 #endif
@@ -112,15 +348,135 @@ class EasyAudio {
 
   void playTrackAndWait(int track) {
     _lastPlaybackTime = millis();
+    _track = track;
+    _playing = false;
 #if ENABLE_EASY_AUDIO == 1
-  #if ENABLE_EASY_AUDIO_PRO == 1
+  #if ENABLE_EASY_AUDIO_PCM == 1
+    playSound(track);
+    while (_player.isPlaying()) {}
+  #elif ENABLE_EASY_AUDIO_PRO == 1
     _player.playFileNum(track, true);
+    _player.flush();
   #else
     _player.playFromMP3Folder(track);
+    _player.flush();
   #endif
     delay(_playbackDelay);
 #endif
   }
 
+private:
+  /**
+   * Works out whether the current track has finished, from whatever the player reports.
+   */
+  void updatePlayback() {
+    if (!_playing) return;
+    unsigned long elapsed = millis() - _lastPlaybackTime;
+#if ENABLE_EASY_AUDIO_PCM == 1
+    if (!_player.isPlaying())
+      trackFinished();
+#elif AUDIO_BUSY_PIN > 0
+    if (digitalRead(AUDIO_BUSY_PIN) == LOW) {
+      _busySeen = true;
+    } else if (_busySeen || elapsed > BUSY_START_TIME) {
+      // back HIGH, or it never went LOW because the track is missing
+      trackFinished();
+    }
+#else
+  #if ENABLE_EASY_AUDIO_PRO == 1
+    saveLength();
+    uint8_t saved = getSavedLength(_track);
+    if (!_trackLength && saved) {
+      _trackLength = saved > 1 ? (saved - 1) * 1000UL : _playbackDelay;
+      _feedback = true;
+    }
+    if (_trackLength && elapsed >= _trackLength) {
+      trackFinished();
+      return;
+    }
+    // the length of this track is not coming, fall back to the busy delay
+    if (!_trackLength && _player.getLengthFailedCount() != _failedCount) {
+      _failedCount = _player.getLengthFailedCount();
+      if (_player.getTotalTimeFile() == _track)
+        _feedback = false;
+    }
+  #else
+    // eg. the track is missing, the Mini will not say it finished
+    if (_player.getErrorCount() != _failedCount) {
+      _failedCount = _player.getErrorCount();
+      _feedback = false;
+    }
+    if (_player.getFinishedCount() != _finishedCount) {
+      _finishedCount = _player.getFinishedCount();
+      _reportsEnd = true;
+      _feedback = true;
+      // ignore the second copy of the reply for the previous track
+      if (elapsed >= FINISHED_GUARD) {
+        trackFinished();
+        return;
+      }
+    }
+  #endif
+    if (!_feedback && elapsed > (unsigned long)_playbackDelay)
+      trackFinished();
+#endif
+  }
+
+  void trackFinished() {
+    _playing = false;
+    if (_finishedCallback) _finishedCallback(_track);
+  }
+
+#if ENABLE_EASY_AUDIO_PRO == 1
+  // keeps the reply to the last length query, so the track is not asked about again
+  void saveLength() {
+    int16_t track = _player.getTotalTimeFile();
+    if (_player.getTotalTime() >= 0 && track > 0 && track <= TRACK_LENGTHS)
+      _trackSeconds[track - 1] = min(_player.getTotalTime(), 254) + 1;
+  }
+
+  // returns the length + 1 of a track in secs, 0 when the player has not said
+  uint8_t getSavedLength(int track) {
+    if (track > 0 && track <= TRACK_LENGTHS)
+      return _trackSeconds[track - 1];
+    if (_player.getTotalTime() >= 0 && _player.getTotalTimeFile() == track)
+      return min(_player.getTotalTime(), 254) + 1;
+    return 0;
+  }
+#endif
+
+#if ENABLE_EASY_AUDIO_PRO == 0 && ENABLE_EASY_AUDIO_PCM == 0
+  // logs the replies that point at a wiring or SD card problem
+  static void onPlayerReply(uint8_t reply, uint16_t param) {
+    if (reply == dfplayer::CARD_REMOVED) {
+      LOG(AUDIO, WARN, F("DFPlayer card removed"));
+    } else if (reply == dfplayer::CARD_INSERTED) {
+      LOG(AUDIO, INFO, F("DFPlayer card inserted"));
+    }
+  }
+#endif
+
+public:
+#if ENABLE_EASY_AUDIO_PCM == 1
+  /**
+   * Called from update() with the track number when an effect has output its first
+   * sample, see EasyMixer::setStartCallback().
+   */
+  void setTrackStartCallback(voice_callback callback) {
+    _player.setStartCallback(callback);
+  }
+
+private:
+  // play the effect for a track from PCM_SOUNDS, tracks without one are skipped
+  void playSound(int track) {
+    for (uint8_t i = 0; i < PCM_SOUND_COUNT; i++) {
+      if (pgm_read_byte(&PCM_SOUNDS[i].track) == track) {
+        _player.play((const int8_t*)pgm_read_ptr(&PCM_SOUNDS[i].data), pgm_read_word(&PCM_SOUNDS[i].length), 255, track);
+        return;
+      }
+    }
+  }
+#endif
+
 };
 #endif
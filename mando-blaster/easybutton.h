@@ -4,6 +4,55 @@
 #include <Arduino.h>
 #include <ezButton.h>
 
+/**
+ * Lock-free ring buffer of timestamped pin edges, written by the pin interrupt
+ * and read from the main loop. The interrupt only moves the head and the main
+ * loop only moves the tail, both are single bytes so no locking is needed.
+ *
+ * Timestamps are the low 16 bits of millis(), so edges must be read within
+ * 65 seconds of being captured.
+ */
+class EasyEdgeBuffer {
+public:
+  static const uint8_t SIZE = 16;   // must be a power of 2
+
+  struct edge {
+    uint16_t time;
+    uint8_t level;
+  };
+
+  EasyEdgeBuffer() {}
+
+  /**
+   * Called from the interrupt. Returns false if the buffer was full and the edge was dropped.
+   */
+  bool push(uint16_t time, uint8_t level) {
+    uint8_t next = (_head + 1) & (SIZE - 1);
+    if (next == _tail) return false;
+    _edges[_head].time = time;
+    _edges[_head].level = level;
+    _head = next;
+    return true;
+  }
+
+  /**
+   * Called from the main loop. Returns false when there are no edges waiting.
+   */
+  bool pop(edge& e) {
+    uint8_t tail = _tail;
+    if (tail == _head) return false;
+    e.time = _edges[tail].time;
+    e.level = _edges[tail].level;
+    _tail = (tail + 1) & (SIZE - 1);
+    return true;
+  }
+
+private:
+  volatile edge _edges[SIZE];
+  volatile uint8_t _head = 0;
+  volatile uint8_t _tail = 0;
+};
+
 /**
  * Use EasyButton to track state on a specific pin.
  * It uses the onboard resistor (INPUT_PULL).
@@ -17,21 +66,53 @@
  *
  * Call the begin() function in the setup to initilize the pin mode, and set a debouce value.
  * eg. selectorOnPin8.begin(25);
- * 
+ *
  * Check the state, and use the defines to determine current state:
  * eg.int selectedMode = selectorOnPin8.checkState()
- * 
+ *
+ * When ENABLE_EASY_BUTTON_ISR is set and the pin supports an external interrupt,
+ * edges are captured by the interrupt and timestamped as they happen. checkState()
+ * then debounces and classifies them from those timestamps, so a press is never
+ * missed or delayed by a slow main loop. Each call reports at most one change,
+ * so presses that arrive while the loop is busy are reported one after another.
+ * Other pins fall back to polling with ezButton.
+ *
  * REQUIRED LIBRARIES - ezButton
  */
 class EasyButton {
 private:
   ezButton _button;
+  uint8_t _pin;
   bool _longPressOnRelease = true;
   unsigned long _pressedTime  = 0;
   unsigned long _releasedTime = 0;
   bool _isPressing     = false;
   bool _isLongDetected = false;
 
+  // interrupt capture
+  EasyEdgeBuffer _edges;
+  bool _captureEdges = false;
+  unsigned long _debounceTime = 50;
+  uint8_t _stableLevel = HIGH;       // debounced pin level
+  uint8_t _rawLevel = HIGH;          // last level seen on the pin
+  unsigned long _rawTime = 0;        // time of the last edge
+  unsigned long _acceptedTime = 0;   // time of the last debounced change
+
+  static const uint8_t EDGE_NONE    = 0;
+  static const uint8_t EDGE_PRESS   = 1;
+  static const uint8_t EDGE_RELEASE = 2;
+
+  static EasyButton*& isrOwner(uint8_t irq) {
+    static EasyButton* owners[2] = {0, 0};
+    return owners[irq];
+  }
+  static void captureInt0() { isrOwner(0)->captureEdge(); }
+  static void captureInt1() { isrOwner(1)->captureEdge(); }
+
+  void captureEdge() {
+    _edges.push((uint16_t)millis(), digitalRead(_pin));
+  }
+
 public:
   static const int BUTTON_NOT_PRESSED   = 0;
   static const int BUTTON_PRESSED       = 1;
@@ -42,37 +123,59 @@ class EasyButton {
 
 #if ENABLE_EASY_BUTTON == 1
   EasyButton(uint8_t pin, bool signalOnRelease = true)
-    : _button(pin) {
+    : _button(pin), _pin(pin) {
     _longPressOnRelease = signalOnRelease;
     _button.setDebounceTime(50);  // set debounce time to 50 milliseconds
   }
 #else
   // do not initialize the button on the pin
   EasyButton(uint8_t pin, bool signalOnRelease = true)
-    : _button(-1) {
+    : _button(-1), _pin(pin) {
     _longPressOnRelease = signalOnRelease;
     _button.setDebounceTime(50);  // set debounce time to 50 milliseconds
   }
 #endif
   void begin(int debounce) {
     _button.setDebounceTime(debounce);
+    _debounceTime = debounce;
+#if ENABLE_EASY_BUTTON == 1 && ENABLE_EASY_BUTTON_ISR == 1
+    int irq = digitalPinToInterrupt(_pin);
+    if (irq == 0 || irq == 1) {
+      pinMode(_pin, INPUT_PULLUP);
+      _stableLevel = _rawLevel = digitalRead(_pin);
+      _rawTime = _acceptedTime = millis();
+      isrOwner(irq) = this;
+      attachInterrupt(irq, irq == 0 ? captureInt0 : captureInt1, CHANGE);
+      _captureEdges = true;
+    }
+#endif
+  }
+
+  /**
+   * Returns True when edges are captured by the pin interrupt.
+   */
+  bool isCapturingEdges() {
+    return _captureEdges;
   }
 
   int checkState() {
+    PROFILE_SCOPE(easyprofile::BUTTON);
 #if ENABLE_EASY_BUTTON == 1
-    _button.loop();  // MUST call the loop() function first
     // track previous state to capture initial press
     bool wasPressed = _isPressing;
-    if (_button.isPressed()) {
+    unsigned long edgeTime = 0;
+    uint8_t edge = _captureEdges ? nextCapturedEdge(edgeTime) : nextPolledEdge(edgeTime);
+
+    if (edge == EDGE_PRESS) {
       //Serial.println(F("button pressed"));
-      _pressedTime = millis();
+      _pressedTime = edgeTime;
       _isPressing = true;
       _isLongDetected = false;
     }
 
-    if (_button.isReleased() && _isPressing == true) {
+    if (edge == EDGE_RELEASE && _isPressing == true) {
       //Serial.println(F("button released"));
-      _releasedTime = millis();
+      _releasedTime = edgeTime;
       long pressDuration = _releasedTime - _pressedTime;
       //Serial.println(pressDuration);
 
@@ -118,6 +221,17 @@ class EasyButton {
     return BUTTON_NOT_PRESSED;
   }
 
+  /**
+   * Returns the ms of the last press and release edges.
+   */
+  unsigned long getPressedTime() {
+    return _pressedTime;
+  }
+
+  unsigned long getReleasedTime() {
+    return _releasedTime;
+  }
+
   bool pressedLongerThan(int duration) {
     // if the button is still pressed use millis()
     if (_isPressing) {
@@ -126,6 +240,53 @@ class EasyButton {
     // if the button was released use _releaseTime
     return (_releasedTime - _pressedTime) > duration;
   }
+
+private:
+  /**
+   * Polls the pin through ezButton, edges are timestamped when they are seen.
+   */
+  uint8_t nextPolledEdge(unsigned long& time) {
+    _button.loop();  // MUST call the loop() function first
+    time = millis();
+    if (_button.isPressed()) return EDGE_PRESS;
+    if (_button.isReleased()) return EDGE_RELEASE;
+    return EDGE_NONE;
+  }
+
+  /**
+   * Reads captured edges until one makes a debounced change. The first edge
+   * after a quiet period is accepted straight away, then further edges are
+   * ignored for the debounce time. If the pin settled on a different level
+   * during that time, the change is reported once the debounce time is over,
+   * stamped with the time the pin settled.
+   */
+  uint8_t nextCapturedEdge(unsigned long& time) {
+    unsigned long now = millis();
+    EasyEdgeBuffer::edge e;
+    while (_edges.pop(e)) {
+      _rawLevel = e.level;
+      _rawTime = now - (uint16_t)((uint16_t)now - e.time);
+      if (_rawLevel != _stableLevel && (_rawTime - _acceptedTime) >= _debounceTime)
+        return acceptEdge(_rawTime, time);
+    }
+
+    // catch up if an edge was missed, eg. the buffer was full
+    uint8_t level = digitalRead(_pin);
+    if (level != _rawLevel) {
+      _rawLevel = level;
+      _rawTime = now;
+    }
+    if (_rawLevel != _stableLevel && (now - _acceptedTime) >= _debounceTime)
+      return acceptEdge(_rawTime, time);
+    return EDGE_NONE;
+  }
+
+  uint8_t acceptEdge(unsigned long edgeTime, unsigned long& time) {
+    _stableLevel = _rawLevel;
+    _acceptedTime = edgeTime;
+    time = edgeTime;
+    return (_stableLevel == LOW) ? EDGE_PRESS : EDGE_RELEASE;
+  }
 };
 
 #endif
@@ -0,0 +1,82 @@
+#ifndef easyevent_h
+#define easyevent_h
+
+#include <Arduino.h>
+#include "easyqueue.h"
+
+/**
+ * An event passed between the stages of the main loop. The sketch defines the types.
+ */
+struct EasyEvent {
+  uint8_t type;
+  int16_t param;
+};
+
+/**
+ * A fixed-size queue of events between two stages of the main loop, eg. the inputs
+ * and the blaster state machine. All storage is allocated at compile time.
+ *
+ * Use the declaration to set the number of events that can wait:
+ * eg. EasyEventQueue<8> events;
+ *
+ * The producing stage posts events, the consuming stage takes them in order:
+ * eg. events.post(EVENT_FIRE_PRESSED);
+ * eg. EasyEvent e;
+ *     while (events.next(e)) { ... }
+ *
+ * A full queue drops the new event and counts it, see getDropped(). Like EasyQueue,
+ * it is not safe to share with an ISR.
+ */
+template <uint8_t SIZE>
+class EasyEventQueue {
+private:
+  EasyQueue<EasyEvent, SIZE> _queue;
+  uint8_t _dropped = 0;
+  uint8_t _highWater = 0;
+
+public:
+  EasyEventQueue() {}
+
+  /**
+   * Adds an event. Returns False, and drops it, when the queue is full.
+   */
+  bool post(uint8_t type, int16_t param = 0) {
+    EasyEvent* e = _queue.pushSlot();
+    if (!e) {
+      _dropped++;
+      LOG(CORE, WARN, F("Event queue full, event dropped"));
+      return false;
+    }
+    e->type = type;
+    e->param = param;
+    if (_queue.size() > _highWater) _highWater = _queue.size();
+    return true;
+  }
+
+  /**
+   * Takes the oldest event. Returns False when there is none.
+   */
+  bool next(EasyEvent& e) {
+    if (_queue.isEmpty()) return false;
+    e = _queue.front();
+    _queue.pop();
+    return true;
+  }
+
+  bool isEmpty() const { return _queue.isEmpty(); }
+  uint8_t size() const { return _queue.size(); }
+
+  /**
+   * Returns a running count of events dropped, wraps at 255.
+   */
+  uint8_t getDropped() const { return _dropped; }
+
+  /**
+   * Returns the most events that have been waiting at once.
+   */
+  uint8_t getHighWater() const { return _highWater; }
+
+  void clear() { _queue.clear(); }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef easyheat_h
+#define easyheat_h
+
+#include <Arduino.h>
+
+/**
+ * A rolling heat model for the blaster barrel. Each shot adds a fixed amount of
+ * heat, and each tick the barrel loses a fixed fraction of its heat, so it cools
+ * quickly when hot and slowly when warm. Integer math only, a tick is a shift
+ * and a subtract.
+ *
+ * Heat is 16 bit, 65535 is as hot as it gets. Use the begin to set the heat per
+ * shot, the cooling per tick as a shift, and the overheat and cooled thresholds:
+ * eg. EasyHeat heat;
+ *     heat.begin(4000, 5, 50000, 16000);   // lose 1/32 per tick, lock out above 50000 until 16000
+ *
+ * Call tick() at a fixed rate, eg. from a scheduler task, and addShot() for each
+ * shot. With a tick of t ms and a shift of s, heat falls by two thirds in about
+ * t * 2^s ms.
+ * eg. if (heat.addShot()) ... just overheated, play the vent
+ * eg. if (heat.isOverheated()) ... locked out until it cools
+ */
+class EasyHeat {
+private:
+  uint16_t _heat = 0;
+  uint16_t _shotHeat = 0;
+  uint16_t _overheat = 0xFFFF;
+  uint16_t _cooled = 0;
+  uint8_t _decayShift = 5;
+  bool _overheated = false;
+  uint8_t _overheats = 0;
+
+public:
+  EasyHeat() {}
+
+  void begin(uint16_t shotHeat, uint8_t decayShift, uint16_t overheat, uint16_t cooled) {
+    _shotHeat = shotHeat;
+    _decayShift = decayShift;
+    _overheat = overheat;
+    _cooled = cooled;
+    reset();
+  }
+
+  /**
+   * Adds the heat of a shot. Returns True when the shot overheats the barrel.
+   */
+  bool addShot() {
+#if ENABLE_EASY_HEAT == 1
+    _heat = (_heat > 0xFFFF - _shotHeat) ? 0xFFFF : _heat + _shotHeat;
+    if (!_overheated && _heat >= _overheat) {
+      _overheated = true;
+      _overheats++;
+      return true;
+    }
+#endif
+    return false;
+  }
+
+  /**
+   * Cools the barrel by one tick. Returns True when it has cooled enough to end
+   * an overheat.
+   */
+  bool tick() {
+    if (_heat == 0) return false;
+    uint16_t loss = _heat >> _decayShift;
+    _heat -= loss ? loss : 1;   // always reach 0
+    if (_overheated && _heat <= _cooled) {
+      _overheated = false;
+      return true;
+    }
+    return false;
+  }
+
+  bool isOverheated() {
+    return _overheated;
+  }
+
+  uint16_t getHeat() {
+    return _heat;
+  }
+
+  /**
+   * Returns the heat scaled to 0-255, eg. to blend a color.
+   */
+  uint8_t getLevel() {
+    return _heat >> 8;
+  }
+
+  /**
+   * Returns a running count of overheats, wraps at 255.
+   */
+  uint8_t getOverheats() {
+    return _overheats;
+  }
+
+  /**
+   * Sets the heat, eg. to restore the barrel from a trace.
+   */
+  void setHeat(uint16_t heat, bool overheated) {
+    _heat = heat;
+    _overheated = overheated;
+  }
+
+  void reset() {
+    _heat = 0;
+    _overheated = false;
+  }
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef easyledengine_h
+#define easyledengine_h
+
+#include <FastLED.h>
+#include "ezPattern.h"
+
+/**
+ * Drives several WS2812 strips, each split into segments that run their own pattern.
+ *
+ * Each strip is one FastLED controller on its own pin. The pixels are owned by the sketch,
+ * and the declaration sets the most strips and segments that can be added:
+ * eg. CRGB barrelLeds[24];
+ *     CRGB scopeLeds[4];
+ *     EasyLedEngine<2, 3> leds;
+ *
+ * In the setup, add the strips, map segments onto ranges of them, then begin().
+ * eg. int8_t barrel = leds.addStrip<BARREL_LED_PIN>(barrelLeds, 24);
+ *     int8_t scope  = leds.addStrip<SCOPE_LED_PIN>(scopeLeds, 4);
+ *     int8_t muzzle = leds.addSegment(barrel, 0, 8);
+ *     int8_t ring   = leds.addSegment(barrel, 8, 16);
+ *     int8_t glow   = leds.addSegment(scope, 0, 4);
+ *     leds.begin(75);
+ *
+ * Patterns are activated per segment, each segment needs its own pattern instance.
+ * The patterns are all of the PATTERN class, ezBlasterShot unless the declaration
+ * says otherwise, so each call goes straight to it:
+ * eg. leds.activate(muzzle, hotshot);
+ * eg. EasyLedEngine<2, 3, ezBlasterShot> leds;
+ *
+ * Call updateDisplay() and then commit() once per loop. commit() is the only place
+ * pixels are pushed: the power limited brightness is worked out once per frame, and
+ * only strips with a changed pixel are written. A frame that only changes the muzzle
+ * pays the interrupt-off time of the barrel strip, not of every strip.
+ *
+ * REQUIRED LIBRARY: FastLED
+ */
+template <uint8_t MAX_STRIPS, uint8_t MAX_SEGMENTS, class PATTERN = ezBlasterShot>
+class EasyLedEngine
+{
+  protected:
+    struct strip {
+      CLEDController *controller;
+      CRGB *leds;
+      uint16_t count;
+      bool dirty;           // pixels changed since the last commit
+    };
+    struct segment {
+      uint8_t strip;
+      uint16_t start;       // first pixel on the strip
+      uint8_t count;
+      PATTERN *pattern;
+    };
+
+    strip _strips[MAX_STRIPS];
+    segment _segments[MAX_SEGMENTS];
+    uint8_t _stripCount   = 0;
+    uint8_t _segmentCount = 0;
+    uint8_t _brightness   = 255;
+    uint8_t _lastScale    = 0;      // brightness used for the last push
+    uint32_t _maxPower    = 2250;   // mW, 5v and 450mA
+
+    bool isSegment(int8_t seg) {
+      return seg >= 0 && seg < _segmentCount;
+    }
+
+    CRGB *segmentLeds(int8_t seg) {
+      return _strips[_segments[seg].strip].leds + _segments[seg].start;
+    }
+
+  public:
+    EasyLedEngine() {};
+
+    /**
+     * Adds a strip of count pixels on PIN. Returns the strip id, or -1 if there is no room.
+     */
+    template <uint8_t PIN>
+    int8_t addStrip(CRGB *leds, uint16_t count) {
+#if ENABLE_EASY_LED == 1
+      if (_stripCount >= MAX_STRIPS || count == 0 || PIN == 0) return -1;
+      strip &s = _strips[_stripCount];
+      s.controller = &FastLED.addLeds<WS2812, PIN, GRB>(leds, count);
+      s.leds = leds;
+      s.count = count;
+      s.dirty = true;
+      return _stripCount++;
+#else
+      return -1;
+#endif
+    }
+
+    /**
+     * Maps a segment onto count pixels of a strip, from start.
+     * Returns the segment id, or -1 if there is no room or the range is not on the strip.
+     */
+    int8_t addSegment(int8_t strip, uint16_t start, uint8_t count) {
+      if (strip < 0 || strip >= _stripCount || _segmentCount >= MAX_SEGMENTS) return -1;
+      if (count == 0 || start + count > _strips[strip].count) return -1;
+      segment &seg = _segments[_segmentCount];
+      seg.strip = strip;
+      seg.start = start;
+      seg.count = count;
+      seg.pattern = 0;
+      return _segmentCount++;
+    }
+
+    void begin(uint8_t brightness) {
+      _brightness = brightness;
+      clear();
+    }
+
+    void setBrightness(uint8_t brightness) {
+      _brightness = brightness;
+    }
+
+    void setMaxPower(uint8_t volts, uint32_t milliamps) {
+      _maxPower = volts * milliamps;
+    }
+
+    //===============================================================
+    // Apply LED color changes, they are pushed on the next commit()
+    void clear() {
+#if ENABLE_EASY_LED == 1
+      for (uint8_t i = 0; i < _stripCount; i++) {
+        fill_solid(_strips[i].leds, _strips[i].count, CRGB::Black);
+        _strips[i].dirty = true;
+      }
+#endif
+    }
+
+    // fill a segment with solid color
+    void fill(int8_t seg, CRGB color) {
+#if ENABLE_EASY_LED == 1
+      if (!isSegment(seg)) return;
+      fill_solid(segmentLeds(seg), _segments[seg].count, color);
+      _strips[_segments[seg].strip].dirty = true;
+#endif
+    }
+
+    // Set a LED color within a segment
+    void setPixel(int8_t seg, uint8_t pixel, CRGB color) {
+#if ENABLE_EASY_LED == 1
+      if (!isSegment(seg) || pixel >= _segments[seg].count) return;
+      segmentLeds(seg)[pixel] = color;
+      _strips[_segments[seg].strip].dirty = true;
+#endif
+    }
+
+    bool isActivated(int8_t seg) {
+      if (isSegment(seg) && _segments[seg].pattern)
+        return _segments[seg].pattern->isActivated();
+      return false;
+    }
+
+    /**
+     * Sets the pattern to run on a segment. Expects an instance of PATTERN.
+     */
+    void activate(int8_t seg, PATTERN &ptn) {
+#if ENABLE_EASY_LED == 1
+      if (!isSegment(seg)) return;
+      _segments[seg].pattern = &ptn;
+      ptn.activate(segmentLeds(seg), _segments[seg].count);
+#endif
+    }
+
+    /**
+     * Runs the pattern of every segment. Returns True while any pattern is active.
+     */
+    bool updateDisplay() {
+      bool active = false;
+#if ENABLE_EASY_LED == 1
+      for (uint8_t i = 0; i < _segmentCount; i++) {
+        if (_segments[i].pattern && _segments[i].pattern->updateDisplay(segmentLeds(i), _segments[i].count))
+          active = true;
+      }
+#endif
+      return active;
+    }
+
+    /**
+     * The single point where pixels are pushed. Only strips with a changed pixel
+     * are written. Returns True if any strip was updated.
+     */
+    bool commit() {
+      bool dirty = false;
+#if ENABLE_EASY_LED == 1
+      for (uint8_t i = 0; i < _segmentCount; i++) {
+        if (_segments[i].pattern && _segments[i].pattern->takeDirty())
+          _strips[_segments[i].strip].dirty = true;
+      }
+      for (uint8_t i = 0; i < _stripCount; i++)
+        dirty |= _strips[i].dirty;
+      if (dirty) show(false);
+#endif
+      return dirty;
+    }
+
+    /**
+     * Push the strips now. When all is false only the changed strips are written,
+     * unless the power limit changed the brightness.
+     */
+    void show(bool all = true) {
+#if ENABLE_EASY_LED == 1
+      uint8_t scale = calculate_max_brightness_for_power_mW(_brightness, _maxPower);
+      if (scale != _lastScale) all = true;
+      _lastScale = scale;
+      for (uint8_t i = 0; i < _stripCount; i++) {
+        if (all || _strips[i].dirty) {
+          _strips[i].controller->showLeds(scale);
+          _strips[i].dirty = false;
+        }
+      }
+#endif
+    }
+};
+
+#endif
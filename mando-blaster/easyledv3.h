@@ -3,6 +3,7 @@
 
 #include <FastLED.h>
 #include "ezPattern.h"
+#include "easyledengine.h"
 
 
 /**
@@ -16,8 +17,14 @@
  * 
  * Use various functions control the leds.
  * eg. leds.clear(); leds.fill(CRGB::Red); leds.show();
+ *
+ * Changes are only pushed to the strip by commit(), and only when a pixel has
+ * changed since the last push. Call it once per loop, after updateDisplay().
+ * Each push disables interrupts for ~30us per led, which upsets SoftwareSerial,
+ * so skipping unchanged frames keeps the audio serial clean under sustained fire.
  * 
- * Led pattern can be activated by passing an ezPattern class. 
+ * Led pattern can be activated by passing an instance of the PATTERN class,
+ * ezBlasterShot unless the declaration says otherwise.
  * e.g. Pulsing Stun - blue
  *   ezBlasterShot stun(CRGB::Blue, CRGB::Blue);
  *   leds.activate(stun); // sets the pattern to display
@@ -25,16 +32,21 @@
  * The main functionality is intended to be non-blocking so the leds display is always
  * called in the main loop.
  *   leds.updateDisplay() // should be added to the main loop
+ *   leds.commit()        // should be added to the main loop, after updateDisplay()
  * 
+ * EasyLedv3 is a single strip, single segment EasyLedEngine. Use EasyLedEngine
+ * directly for more strips, or to split a strip into segments.
+ *
  * REQUIRED LIBRARY: FastLED
  */
-template <int LED_COUNT, int LED_PIN_IN>
+template <int LED_COUNT, int LED_PIN_IN, class PATTERN = ezBlasterShot>
 class EasyLedv3
 {
   protected:
     // variable declaration
     CRGB leds[LED_COUNT];
-    volatile ezPattern *pattern = 0;
+    EasyLedEngine<1, 1, PATTERN> engine;
+    static const int8_t SEGMENT = 0;
 
   public:
     //some constants for functions
@@ -52,11 +64,10 @@ class EasyLedv3
     void begin(int brightness) {
 #if ENABLE_EASY_LED == 1
       if (LED_COUNT > 0 && LED_PIN_IN > 0) {
-        //DBGLN(F("Initializing leds"));
-        FastLED.addLeds<WS2812, LED_PIN_IN, GRB>(leds, LED_COUNT);
-        FastLED.setBrightness(brightness);
-        FastLED.setMaxPowerInVoltsAndMilliamps(5, 450); //5v and 450mA
-        clear();
+        LOG(LED, DEBUG, F("Initializing leds"));
+        engine.addSegment(engine.template addStrip<LED_PIN_IN>(leds, LED_COUNT), 0, LED_COUNT);
+        engine.setMaxPower(5, 450); //5v and 450mA
+        engine.begin(brightness);
       }
 #endif
     }
@@ -64,70 +75,56 @@ class EasyLedv3
     //===============================================================
     // Apply LED color changes
     void clear() {
-#if ENABLE_EASY_LED == 1
-        FastLED.clear();
-        FastLED.show();
-#endif
+      engine.clear();
     }
 
+    // push the leds to the strip now, whether or not they changed
     void show() {
-#if ENABLE_EASY_LED == 1
-      FastLED.show();
-#endif
+      engine.show();
+    }
+
+    /**
+     * The single point where the leds are pushed to the strip. Skips the push
+     * when no pixel changed since the last one. Returns True if the strip was updated.
+     */
+    bool commit() {
+      return engine.commit();
     }
 
     // fill all leds with solid color
     void fill(CRGB color) {
-#if ENABLE_EASY_LED == 1
-        fill_solid(leds, LED_COUNT, color);
-#endif
+      engine.fill(SEGMENT, color);
     }
 
     // Set a LED color (not yet visible)
     void setPixel(int Pixel, byte red, byte green, byte blue) {
-#if ENABLE_EASY_LED == 1
-      if (Pixel < LED_COUNT) {
-        leds[Pixel].r = red;
-        leds[Pixel].g = green;
-        leds[Pixel].b = blue;
-      }
-#endif
+      if (Pixel < LED_COUNT)
+        engine.setPixel(SEGMENT, Pixel, CRGB(red, green, blue));
     }
 
     /**
      *
      */    
     bool isActivated(void) {
-      if (pattern)
-        return pattern->isActivated();
-      return false;
+      return engine.isActivated(SEGMENT);
     }
 
     /**
-     * Sets the pattern to activate the leds. Expects an instance of ezPattern.
+     * Sets the pattern to activate the leds. Expects an instance of PATTERN.
      * See ezPattern for classes.
      */
-    void activate(ezPattern &ptn) {
-#if ENABLE_EASY_LED == 1
-      //DBGLN(F("activating led pattern"));
-      pattern = &ptn;
-      if (pattern)
-        pattern->activate(leds, LED_COUNT);
-#endif
+    void activate(PATTERN &ptn) {
+      LOG(LED, DEBUG, F("activating led pattern"));
+      engine.activate(SEGMENT, ptn);
     }
 
     /**
      * This should be called in the main program loop().
-     * The call is a proxy to the ezPattern, if one has been provided.
+     * The call is a proxy to the pattern, if one has been provided.
      */
     bool updateDisplay() {
-#if ENABLE_EASY_LED == 1
-      if(LED_COUNT > 0 && LED_PIN_IN > 0) {
-        if (pattern)
-          return pattern->updateDisplay(leds, LED_COUNT);
-      }
-#endif
-      return false;
+      PROFILE_SCOPE(easyprofile::LEDS);
+      return engine.updateDisplay();
     }
 };
 
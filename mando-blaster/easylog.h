@@ -0,0 +1,122 @@
+#ifndef easylog_h
+#define easylog_h
+
+#include <Arduino.h>
+
+/**
+ * A debug log that never blocks the main loop. Messages are copied to a RAM
+ * buffer, and update() sends them on as the serial port has room, so a message
+ * costs the time to copy it whatever the baud rate.
+ *
+ * Use the declaration to set the buffer size in bytes, and the port:
+ * eg. EasyLog<96> debugLog(Serial);
+ *
+ * Only whole lines are sent. A line that does not fit in the buffer is dropped,
+ * along with the part of it already copied, and counted, see getDropped().
+ * Call update() often, eg. from a scheduler task:
+ * eg. debugLog.update();
+ *
+ * The sketch logs through the LOG macro in config.h, which leaves out the
+ * messages below the level of their module at compile time:
+ * eg. LOG(AUDIO, WARN, F("DFPlayer queue full, command dropped"));
+ * eg. LOG(BLASTER, INFO, F("Ammo mode selected: "), mode);
+ * eg. LOG(AUDIO, ERROR, F("DFPlayer error: "), error, HEX);
+ */
+template <uint16_t SIZE>
+class EasyLog : public Print {
+private:
+  Print* _out;
+  uint8_t _buffer[SIZE];
+  uint16_t _head = 0;           // slot of the next byte
+  uint16_t _count = 0;
+  uint16_t _lineLength = 0;     // bytes of the line being written, not sent yet
+  bool _dropping = false;       // drop the rest of the line
+  uint8_t _dropped = 0;
+
+public:
+  EasyLog(Print& out) : _out(&out) {}
+
+  /**
+   * Copies a byte to the buffer. Always returns 1, so a dropped line does not
+   * stop the print of a number half way.
+   */
+  size_t write(uint8_t b) {
+    if (_dropping) {
+      if (b == '\n') _dropping = false;
+      return 1;
+    }
+    if (_count == SIZE) {
+      // take back the start of the line, the rest of it is dropped as it comes
+      _head = (_head + SIZE - _lineLength) % SIZE;
+      _count -= _lineLength;
+      _lineLength = 0;
+      _dropped++;
+      _dropping = (b != '\n');
+      return 1;
+    }
+    _buffer[_head] = b;
+    if (++_head == SIZE) _head = 0;
+    _count++;
+    _lineLength = (b == '\n') ? 0 : _lineLength + 1;
+    return 1;
+  }
+  using Print::write;
+
+  /**
+   * Writes a message and ends the line, see the LOG macro.
+   */
+  template <typename T>
+  void line(T a) {
+    println(a);
+  }
+
+  template <typename T, typename U>
+  void line(T a, U b) {
+    print(a);
+    println(b);
+  }
+
+  template <typename T, typename U>
+  void line(T a, U b, int base) {
+    print(a);
+    println(b, base);
+  }
+
+  template <typename T, typename U, typename V, typename W>
+  void line(T a, U b, V c, W d) {
+    print(a);
+    print(b);
+    print(c);
+    println(d);
+  }
+
+  /**
+   * Sends the whole lines that fit in the port's transmit buffer.
+   */
+  void update() {
+    int room = _out->availableForWrite();
+    uint16_t tail = (_head + SIZE - _count) % SIZE;
+    while (room > 0 && _count > _lineLength) {
+      _out->write(_buffer[tail]);
+      if (++tail == SIZE) tail = 0;
+      _count--;
+      room--;
+    }
+  }
+
+  /**
+   * Returns the bytes waiting to be sent.
+   */
+  uint16_t size() {
+    return _count;
+  }
+
+  /**
+   * Returns a running count of lines dropped, wraps at 255.
+   */
+  uint8_t getDropped() {
+    return _dropped;
+  }
+};
+
+#endif
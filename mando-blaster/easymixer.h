@@ -0,0 +1,231 @@
+#ifndef easymixer_h
+#define easymixer_h
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+namespace easymixer {
+  static const uint8_t VOICES       = 4;      // sounds that can play at the same time
+  static const uint16_t SAMPLE_RATE = 8000;   // Hz, of the samples and the mixer interrupt
+  static const uint8_t SILENCE      = 128;    // PWM duty for a zero sample
+}
+
+/**
+ * A sound effect stored in PROGMEM, signed 8 bit mono at easymixer::SAMPLE_RATE.
+ * The track number matches the AUDIO_TRACK_* the DF players use for the same effect.
+ */
+struct EasyPcmSound {
+  uint8_t track;
+  const int8_t *data;
+  uint16_t length;
+};
+
+typedef void (*voice_callback)(uint8_t voice, uint8_t id, uint16_t played);  // played samples so far
+
+/**
+ * EasyMixer plays up to four PCM sound effects at the same time, mixed in software.
+ *
+ * Timer1 interrupts at the sample rate, mixes one sample from each playing voice
+ * and writes it to the Timer2 PWM duty. The PWM runs at 62.5kHz on pin 11 (OC2A),
+ * so a simple RC filter and an amp are enough to drive a speaker. The sketch defines
+ * the interrupt once, in a .cpp, and calls the mixer from it:
+ * eg. EasyMixer mixer;
+ *     mixer.begin();
+ * eg. ISR(TIMER1_COMPA_vect) { EasyMixer::isr(); }
+ *
+ * play() starts a sound on a free voice and returns straight away, the first sample
+ * goes out on the next interrupt, within 125us. The interrupt only marks the voices
+ * it starts, update() reports them to the start callback from the main loop:
+ * eg. mixer.update(); When all voices are busy the one that
+ * has played the longest is cut off. Each voice has its own volume, and there is a
+ * master volume on top, 255 is full volume.
+ * eg. mixer.play(PCM_FIRE_A, sizeof(PCM_FIRE_A), 200);
+ *
+ * Timer1 and Timer2 are used by the mixer, so tone(), Servo and AltSoftSerial can not
+ * be used with it. FastLED turns interrupts off while it writes the leds, samples
+ * are late by that time, about 30us per led.
+ */
+class EasyMixer {
+private:
+  struct voice {
+    const int8_t *data;
+    uint16_t length;
+    uint16_t position;      // next sample, only moved by the interrupt while playing
+    uint8_t volume;
+    uint8_t id;             // passed to the start callback, eg. the track number
+  };
+
+  voice _voices[easymixer::VOICES];
+  volatile uint8_t _playing = 0;      // bit per voice
+  volatile uint8_t _starting = 0;     // bit per voice that has not output a sample yet
+  volatile uint8_t _started = 0;      // bit per voice started since the last update()
+  volatile uint8_t _master = 255;
+  voice_callback _startCallback = 0;
+
+  static EasyMixer*& instance() {
+    static EasyMixer* mixer = 0;
+    return mixer;
+  }
+
+  // pick a free voice, or the one that has played the longest
+  uint8_t nextVoice() {
+    uint8_t oldest = 0;
+    uint16_t played = 0;
+    for (uint8_t i = 0; i < easymixer::VOICES; i++) {
+      if (!(_playing & (1 << i))) return i;
+      uint16_t position;
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        position = _voices[i].position;   // 2 bytes, the interrupt may move it between them
+      }
+      if (position >= played) {
+        played = position;
+        oldest = i;
+      }
+    }
+    return oldest;
+  }
+
+public:
+  EasyMixer() {};
+
+  /**
+   * Starts the PWM output and the mixer interrupt.
+   */
+  bool begin() {
+    instance() = this;
+    pinMode(PCM_AUDIO_PIN, OUTPUT);
+    noInterrupts();
+    // Timer2 - fast PWM on OC2A, no prescaler
+    TCCR2A = _BV(COM2A1) | _BV(WGM21) | _BV(WGM20);
+    TCCR2B = _BV(CS20);
+    OCR2A = easymixer::SILENCE;
+    // Timer1 - CTC, compare match interrupt at the sample rate
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS10);
+    OCR1A = F_CPU / easymixer::SAMPLE_RATE - 1;
+    TIMSK1 |= _BV(OCIE1A);
+    interrupts();
+    return true;
+  }
+
+  /**
+   * Plays length samples from data in PROGMEM. Returns the voice it plays on.
+   */
+  uint8_t play(const int8_t *data, uint16_t length, uint8_t volume = 255, uint8_t id = 0) {
+    uint8_t v = nextVoice();
+    uint8_t bit = 1 << v;
+    noInterrupts();
+    _playing &= ~bit;
+    _started &= ~bit;     // the sound it cuts off is not reported
+    interrupts();
+    _voices[v].data = data;
+    _voices[v].length = length;
+    _voices[v].position = 0;
+    _voices[v].volume = volume;
+    _voices[v].id = id;
+    if (length == 0) return v;
+    noInterrupts();
+    _starting |= bit;
+    _playing |= bit;
+    interrupts();
+    return v;
+  }
+
+  void stop(uint8_t voice) {
+    noInterrupts();
+    _playing &= ~(1 << voice);
+    interrupts();
+  }
+
+  void stopAll() {
+    _playing = 0;
+  }
+
+  void setVolume(uint8_t voice, uint8_t volume) {
+    _voices[voice].volume = volume;
+  }
+
+  void setMasterVolume(uint8_t volume) {
+    _master = volume;
+  }
+
+  /**
+   * Returns True while any voice is playing.
+   */
+  bool isPlaying() {
+    return _playing != 0;
+  }
+
+  bool isPlaying(uint8_t voice) {
+    return (_playing & (1 << voice)) != 0;
+  }
+
+  /**
+   * Called from update() for each voice that has output its first sample since the
+   * last update, with the samples it has played by then. The first sample went out
+   * about played / SAMPLE_RATE seconds before the call.
+   */
+  void setStartCallback(voice_callback callback) {
+    _startCallback = callback;
+  }
+
+  /**
+   * Reports the voices the interrupt started to the start callback. Call it in the
+   * main loop, the callback does not run in the interrupt.
+   */
+  void update() {
+    uint8_t started;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      started = _started;
+      _started = 0;
+    }
+    if (!started || !_startCallback) return;
+    for (uint8_t i = 0; i < easymixer::VOICES; i++) {
+      if (!(started & (1 << i))) continue;
+      uint16_t played;
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        played = _voices[i].position;
+      }
+      _startCallback(i, _voices[i].id, played);
+    }
+  }
+
+  /**
+   * Mixes the next sample of every playing voice, returns the PWM duty.
+   * Called by the interrupt.
+   */
+  uint8_t nextSample() {
+    int16_t mix = 0;
+    uint8_t master = _master;
+    uint8_t playing = _playing;
+    uint8_t starting = _starting & playing;
+    for (uint8_t i = 0; i < easymixer::VOICES; i++) {
+      uint8_t bit = 1 << i;
+      if (!(playing & bit)) continue;
+      voice &v = _voices[i];
+      int8_t sample = (int8_t)pgm_read_byte(v.data + v.position);
+      uint8_t volume = ((uint16_t)v.volume * master) >> 8;
+      mix += ((int16_t)sample * volume) >> 8;
+      if (++v.position >= v.length)
+        playing &= ~bit;
+    }
+    _playing = playing;
+    _starting &= ~starting;
+    _started |= starting;
+
+    if (mix > 127) mix = 127;
+    if (mix < -128) mix = -128;
+    return (uint8_t)(mix + easymixer::SILENCE);
+  }
+
+  /**
+   * Outputs the next sample, call it from the Timer1 compare match interrupt.
+   */
+  static void isr() {
+    EasyMixer* mixer = instance();
+    if (mixer)
+      OCR2A = mixer->nextSample();
+  }
+};
+
+#endif
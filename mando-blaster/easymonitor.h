@@ -0,0 +1,286 @@
+#ifndef easymonitor_h
+#define easymonitor_h
+
+#include <Arduino.h>
+#if ENABLE_EASY_WATCHDOG == 1
+#include <avr/wdt.h>
+#endif
+
+/**
+ * What the watchdog interrupt saw before it reset the Nano. Keep it in a .noinit
+ * variable, so it is still there in the setup after the reset:
+ * eg. EasyWatchdogRecord watchdogRecord __attribute__((section(".noinit")));
+ */
+struct EasyWatchdogRecord {
+  uint16_t magic;                       // WATCHDOG_MAGIC when the rest is valid
+  const __FlashStringHelper* task;      // the task that hung, NULL between tasks
+  unsigned long time;                   // ms the watchdog fired
+  uint8_t resetFlags;                   // MCUSR at start up, 0 when the bootloader cleared it
+};
+
+/**
+ * Watches the time between loop() passes, so the stalls that happen in the
+ * field leave a record. Each pass is counted in a histogram of powers of two,
+ * from under 128us to 32ms and over. A pass longer than the stall time is a
+ * stall, and is put down to the task that took longest in it.
+ *
+ * Use the begin to set the stall time in us, then check at the end of each
+ * pass with the task the scheduler says took longest:
+ * eg. EasyLoopMonitor monitor;
+ *     monitor.begin(20000);
+ * eg. if (monitor.check(scheduler.getSlowestTask())) ... just stalled
+ *
+ * On the Nano the monitor can also run the hardware watchdog. The first time
+ * out calls an interrupt, which should save the running task, and the second
+ * resets the Nano. A watchdog reset leaves the watchdog running at 15ms, so the
+ * first lines of setup stop it and save the reset flags, and the end of setup
+ * reads the record, clears it and starts the watchdog again:
+ * eg. EasyLoopMonitor::saveResetFlags(watchdogRecord);
+ * eg. monitor.beginWatchdog(watchdogRecord, WDTO_2S);
+ * eg. ISR(WDT_vect) { monitor.watchdogInterrupt(scheduler.getCurrentTask()); }
+ *
+ * Print the loop times and start again. printLine() writes one line, so a task
+ * can send a few lines each pass as the port has room:
+ * eg. monitor.print(Serial);
+ *     monitor.reset();
+ * eg. if (!monitor.printLine(Serial, line++)) monitor.reset();
+ *   LOOP <millis>
+ *   <128us=<passes> <256us=<passes> ... <2ms=<passes>
+ *   <4ms=<passes> ... >=32ms=<passes>
+ *   stalls=<count> worst=<us> in <task> last=<us> in <task> at <ms>
+ *   watchdog reset in <task> at <ms>     - after a watchdog reset
+ *   END
+ */
+class EasyLoopMonitor {
+public:
+  static const uint8_t BUCKETS = 10;               // <128us, doubling to <32ms, then 32ms and over
+  static const uint16_t WATCHDOG_MAGIC = 0xB1A5;
+
+private:
+  unsigned long _histogram[BUCKETS];              // passes, stop at 0xFFFFFFFF
+  unsigned long _stallTime = 0xFFFFFFFFUL;         // us
+  unsigned long _lastPass = 0;                     // us at the end of the last pass
+  bool _started = false;
+  uint16_t _stalls = 0;
+  unsigned long _worstStall = 0;
+  const __FlashStringHelper* _worstCause = NULL;
+  unsigned long _lastStall = 0;
+  const __FlashStringHelper* _lastCause = NULL;
+  unsigned long _lastStallTime = 0;                // ms
+  EasyWatchdogRecord* _record = NULL;
+  bool _watchdogReset = false;                     // the last reset was the watchdog
+  const __FlashStringHelper* _resetCause = NULL;
+  unsigned long _resetTime = 0;
+  volatile bool _watchdogFired = false;
+
+  void printCause(Print& out, const __FlashStringHelper* cause) {
+    out.print(F(" in "));
+    out.print(cause ? cause : F("loop"));
+  }
+
+public:
+  EasyLoopMonitor() {
+    reset();
+  }
+
+  void begin(unsigned long stallTime) {
+    _stallTime = stallTime;
+    _started = false;
+  }
+
+  /**
+   * Ends a loop() pass. Returns True when the pass was a stall, see getLastStall().
+   */
+  bool check(const __FlashStringHelper* cause) {
+    unsigned long now = micros();
+    unsigned long period = now - _lastPass;
+    _lastPass = now;
+#if ENABLE_EASY_WATCHDOG == 1
+    if (_record) {
+      wdt_reset();
+      if (_watchdogFired) {
+        // the loop came back before the reset, it was a stall not a hang
+        _watchdogFired = false;
+        _record->magic = 0;
+        WDTCSR |= _BV(WDIE);
+      }
+    }
+#endif
+    if (!_started) {
+      _started = true;     // the first pass is timed from setup
+      return false;
+    }
+
+    uint8_t bucket = 0;
+    for (unsigned long us = period >> 7; us && bucket < BUCKETS - 1; us >>= 1)
+      bucket++;
+    // the rare long passes are what matter, so the counts are never scaled down
+    if (_histogram[bucket] != 0xFFFFFFFFUL)
+      _histogram[bucket]++;
+
+    if (period < _stallTime)
+      return false;
+    if (_stalls < 0xFFFF) _stalls++;
+    _lastStall = period;
+    _lastCause = cause;
+    _lastStallTime = millis();
+    if (period > _worstStall) {
+      _worstStall = period;
+      _worstCause = cause;
+    }
+    return true;
+  }
+
+  uint16_t getStalls() {
+    return _stalls;
+  }
+
+  /**
+   * Returns the length of the last stall in us.
+   */
+  unsigned long getLastStall() {
+    return _lastStall;
+  }
+
+  /**
+   * Returns the task the last stall is put down to, never NULL.
+   */
+  const __FlashStringHelper* getLastCause() {
+    return _lastCause ? _lastCause : F("loop");
+  }
+
+#if ENABLE_EASY_WATCHDOG == 1
+  /**
+   * Saves MCUSR in the record, clears it and stops the watchdog. Call it before
+   * anything else in setup, a watchdog reset leaves the watchdog running at its
+   * shortest time out and MCUSR has to be cleared to stop it.
+   */
+  static void saveResetFlags(EasyWatchdogRecord& record) {
+    record.resetFlags = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+  }
+#endif
+
+  /**
+   * Reads and clears the record of the last watchdog reset, then starts the
+   * watchdog in interrupt and reset mode. Only on AVR, with ENABLE_EASY_WATCHDOG.
+   * The reset flags decide when saveResetFlags() found them, the record alone when
+   * the bootloader had cleared them. The task is only known when the interrupt ran.
+   */
+  void beginWatchdog(EasyWatchdogRecord& record, uint8_t timeout) {
+#if ENABLE_EASY_WATCHDOG == 1
+    _record = &record;
+    bool saved = (record.magic == WATCHDOG_MAGIC);
+    _watchdogReset = record.resetFlags ? (record.resetFlags & _BV(WDRF)) != 0 : saved;
+    _resetCause = NULL;
+    _resetTime = 0;
+    if (_watchdogReset && saved) {
+      _resetCause = record.task;
+      _resetTime = record.time;
+    }
+    record.magic = 0;
+    record.resetFlags = 0;
+    wdt_enable(timeout);
+    WDTCSR |= _BV(WDIE);
+#endif
+  }
+
+  /**
+   * Saves the running task from the watchdog interrupt. The Nano resets on the
+   * next time out, unless the loop comes back first.
+   */
+  void watchdogInterrupt(const __FlashStringHelper* task) {
+    if (!_record) return;
+    _record->task = task;
+    _record->time = millis();
+    _record->magic = WATCHDOG_MAGIC;
+    _watchdogFired = true;
+  }
+
+  /**
+   * Returns True when the Nano was reset by the watchdog, see getResetCause().
+   */
+  bool isWatchdogReset() {
+    return _watchdogReset;
+  }
+
+  const __FlashStringHelper* getResetCause() {
+    return _resetCause ? _resetCause : F("loop");
+  }
+
+  /**
+   * Writes line n of the loop times, see above. The histogram is split over two
+   * lines to keep them short. Returns False when there is no line n, after the END line.
+   */
+  bool printLine(Print& out, uint8_t n) {
+    static const uint8_t BUCKET_MS = 3;   // buckets from here on print in ms
+    static const uint8_t BUCKET_LINE = 5; // buckets on the first line
+    switch (n) {
+      case 0:
+        out.print(F("LOOP "));
+        out.println(millis());
+        return true;
+      case 1:
+      case 2:
+        for (uint8_t i = (n == 1 ? 0 : BUCKET_LINE); i < (n == 1 ? BUCKET_LINE : BUCKETS); i++) {
+          unsigned long limit = 128UL << (i < BUCKETS - 1 ? i : i - 1);
+          out.print(i < BUCKETS - 1 ? F("<") : F(">="));
+          out.print(i >= BUCKET_MS ? limit / 1000 : limit);
+          out.print(i >= BUCKET_MS ? F("ms=") : F("us="));
+          out.print(_histogram[i]);
+          out.print(' ');
+        }
+        out.println();
+        return true;
+      case 3:
+        out.print(F("stalls="));
+        out.print(_stalls);
+        if (_stalls) {
+          out.print(F(" worst="));
+          out.print(_worstStall);
+          printCause(out, _worstCause);
+          out.print(F(" last="));
+          out.print(_lastStall);
+          printCause(out, _lastCause);
+          out.print(F(" at "));
+          out.print(_lastStallTime);
+        }
+        out.println();
+        return true;
+      case 4:
+        if (_watchdogReset) {
+          out.print(F("watchdog reset"));
+          printCause(out, _resetCause);
+          out.print(F(" at "));
+          out.println(_resetTime);
+        }
+        return true;
+      case 5:
+        out.println(F("END"));
+        return true;
+    }
+    return false;
+  }
+
+  void print(Print& out) {
+    for (uint8_t n = 0; printLine(out, n); n++);
+  }
+
+  /**
+   * Clears the histogram and the stalls. The pass that called it is timed from here.
+   */
+  void reset() {
+    for (uint8_t i = 0; i < BUCKETS; i++)
+      _histogram[i] = 0;
+    _stalls = 0;
+    _worstStall = 0;
+    _worstCause = NULL;
+    _lastStall = 0;
+    _lastCause = NULL;
+    _lastStallTime = 0;
+    _lastPass = _started ? micros() : 0;
+  }
+};
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef easyprofile_h
+#define easyprofile_h
+
+#include <Arduino.h>
+
+namespace easyprofile {
+  // probes, each times one hot path
+  static const uint8_t LOOP        = 0;    // a pass of loop()
+  static const uint8_t BUTTON      = 1;    // EasyButton::checkState()
+  static const uint8_t LEDS        = 2;    // EasyLedv3::updateDisplay(), the pattern frames
+  static const uint8_t SHOT_FLASH  = 3;    // ezBlasterShot white flash, the activate and its frames
+  static const uint8_t SHOT_FADE   = 4;    // ezBlasterShot fade frames, to the clear at the end
+  static const uint8_t MINI_SEND   = 5;    // DFPlayerMini::sendData(), a command is queued
+  static const uint8_t MINI_TX     = 6;    // DFPlayerMini::update(), bytes written to the player
+  static const uint8_t PRO_SEND    = 7;    // DFPlayerPro::sendNext(), a command written to the player
+  static const uint8_t PRO_ACK     = 8;    // DFPlayerPro::readAck()
+  static const uint8_t COUNT       = 9;
+}
+
+static const char PROFILE_LOOP[] PROGMEM =        {"loop"};
+static const char PROFILE_BUTTON[] PROGMEM =      {"button"};
+static const char PROFILE_LEDS[] PROGMEM =        {"leds"};
+static const char PROFILE_SHOT_FLASH[] PROGMEM =  {"shot flash"};
+static const char PROFILE_SHOT_FADE[] PROGMEM =   {"shot fade"};
+static const char PROFILE_MINI_SEND[] PROGMEM =   {"mini send"};
+static const char PROFILE_MINI_TX[] PROGMEM =     {"mini tx"};
+static const char PROFILE_PRO_SEND[] PROGMEM =    {"pro send"};
+static const char PROFILE_PRO_ACK[] PROGMEM =     {"pro ack"};
+
+static const char* const PROFILE_NAMES[] PROGMEM = {
+  PROFILE_LOOP, PROFILE_BUTTON, PROFILE_LEDS, PROFILE_SHOT_FLASH, PROFILE_SHOT_FADE,
+  PROFILE_MINI_SEND, PROFILE_MINI_TX, PROFILE_PRO_SEND, PROFILE_PRO_ACK
+};
+
+/**
+ * Execution time of the hot paths, the count, min, max and mean of each probe in
+ * microseconds. The time comes from micros(), so the resolution is 4us on a
+ * 16MHz Nano and each probe adds two micros() calls, a few us.
+ *
+ * The sketch times a block with the PROFILE_SCOPE macro in config.h, from the
+ * macro to the end of the block. It is empty unless ENABLE_EASY_PROFILE is 1:
+ * eg. PROFILE_SCOPE(easyprofile::BUTTON);
+ *
+ * Print the stats, a probe a line, and start again. printLine() writes one line,
+ * so a task can send a few lines each pass as the port has room:
+ * eg. profiler.print(Serial);
+ *     profiler.reset();
+ * eg. if (!profiler.printLine(Serial, line++)) profiler.reset();
+ *   PROFILE <millis>
+ *   <probe>: n=<count> min=<us> max=<us> mean=<us>
+ *   ...
+ *   END
+ * Probes that have not run are left out.
+ */
+class EasyProfile {
+private:
+  struct probe {
+    unsigned long count;
+    unsigned long min;
+    unsigned long max;
+    unsigned long total;
+  };
+  probe _probes[easyprofile::COUNT];
+  unsigned long _resetTime = 0;   // us of the last reset
+
+  void clear() {
+    for (uint8_t i = 0; i < easyprofile::COUNT; i++) {
+      _probes[i].count = 0;
+      _probes[i].min = 0xFFFFFFFFUL;
+      _probes[i].max = 0;
+      _probes[i].total = 0;
+    }
+  }
+
+public:
+  EasyProfile() {
+    clear();
+  }
+
+  /**
+   * Adds the time from start to now to a probe. A time that started before the
+   * last reset is left out, eg. the loop() pass that printed the stats.
+   * The count and the total are halved before the total overflows, after about
+   * 35 minutes of loop() time, so the mean carries on.
+   */
+  void add(uint8_t id, unsigned long start) {
+    unsigned long us = micros() - start;
+    if (id >= easyprofile::COUNT || (long)(start - _resetTime) < 0) return;
+    probe& p = _probes[id];
+    if (p.total > 0x7FFFFFFFUL - us) {
+      p.count >>= 1;
+      p.total >>= 1;
+    }
+    p.count++;
+    p.total += us;
+    if (us < p.min) p.min = us;
+    if (us > p.max) p.max = us;
+  }
+
+  unsigned long getMax(uint8_t id) {
+    return (id < easyprofile::COUNT) ? _probes[id].max : 0;
+  }
+
+  unsigned long getMean(uint8_t id) {
+    if (id >= easyprofile::COUNT || _probes[id].count == 0) return 0;
+    return _probes[id].total / _probes[id].count;
+  }
+
+  /**
+   * Writes line n of the stats, see above. A probe that has not run writes
+   * nothing. Returns False when there is no line n, after the END line.
+   */
+  bool printLine(Print& out, uint8_t n) {
+    if (n == 0) {
+      out.print(F("PROFILE "));
+      out.println(millis());
+    } else if (n <= easyprofile::COUNT) {
+      probe& p = _probes[n - 1];
+      if (p.count == 0) return true;
+      out.print((const __FlashStringHelper*)pgm_read_ptr(&PROFILE_NAMES[n - 1]));
+      out.print(F(": n="));
+      out.print(p.count);
+      out.print(F(" min="));
+      out.print(p.min);
+      out.print(F(" max="));
+      out.print(p.max);
+      out.print(F(" mean="));
+      out.println(p.total / p.count);
+    } else if (n == easyprofile::COUNT + 1) {
+      out.println(F("END"));
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  void print(Print& out) {
+    for (uint8_t n = 0; printLine(out, n); n++);
+  }
+
+  void reset() {
+    _resetTime = micros();
+    clear();
+  }
+};
+
+/**
+ * Times its own lifetime into a probe, see PROFILE_SCOPE.
+ */
+class EasyProfileScope {
+private:
+  EasyProfile& _profile;
+  uint8_t _id;
+  unsigned long _start;
+
+public:
+  EasyProfileScope(EasyProfile& profile, uint8_t id) : _profile(profile), _id(id), _start(micros()) {}
+
+  ~EasyProfileScope() {
+    _profile.add(_id, _start);
+  }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef easyqueue_h
+#define easyqueue_h
+
+#include <Arduino.h>
+
+/**
+ * A fixed-size FIFO ring buffer. All storage is allocated at compile time,
+ * so there is no heap use and every operation is O(1).
+ *
+ * Use the declaration to set the item type and capacity:
+ * eg. EasyQueue<uint8_t, 8> bytes;
+ *
+ * Items are added at the back and removed from the front:
+ * eg. if (!bytes.isFull()) bytes.push(0x7E);
+ * eg. while (!bytes.isEmpty()) { uint8_t b = bytes.front(); bytes.pop(); }
+ *
+ * The queue is not safe to share with an ISR; use it from the main loop only.
+ */
+template <typename T, uint8_t SIZE>
+class EasyQueue {
+private:
+  T _items[SIZE];
+  uint8_t _head = 0;
+  uint8_t _count = 0;
+
+public:
+  EasyQueue() {}
+
+  bool isEmpty() const { return _count == 0; }
+  bool isFull() const { return _count == SIZE; }
+  uint8_t size() const { return _count; }
+  uint8_t capacity() const { return SIZE; }
+
+  /**
+   * Adds an item to the back of the queue.
+   * Returns false, and drops the item, when the queue is full.
+   */
+  bool push(const T& item) {
+    if (isFull()) return false;
+    _items[index(_count)] = item;
+    _count++;
+    return true;
+  }
+
+  /**
+   * Reserves the next slot at the back of the queue so it can be filled in place.
+   * Returns NULL when the queue is full.
+   */
+  T* pushSlot() {
+    if (isFull()) return NULL;
+    T* slot = &_items[index(_count)];
+    _count++;
+    return slot;
+  }
+
+  /**
+   * Removes the item at the front of the queue.
+   */
+  void pop() {
+    if (isEmpty()) return;
+    _head = index(1);
+    _count--;
+  }
+
+  T& front() { return _items[_head]; }
+  T& back() { return _items[index(_count - 1)]; }
+
+  /**
+   * Access by position, 0 is the front of the queue.
+   */
+  T& at(uint8_t pos) { return _items[index(pos)]; }
+
+  void clear() {
+    _head = 0;
+    _count = 0;
+  }
+
+private:
+  uint8_t index(uint8_t offset) const {
+    uint8_t i = _head + offset;
+    return (i >= SIZE) ? i - SIZE : i;
+  }
+};
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef easyscheduler_h
+#define easyscheduler_h
+
+#include <Arduino.h>
+
+typedef void (*task_function)(void); // type for conciseness
+
+/**
+ * A small cooperative scheduler for the main loop. Each task is a plain function
+ * with a period and a deadline, both in microseconds. Task slots are allocated
+ * at compile time, so there is no heap use.
+ *
+ * Use the declaration to set the number of task slots:
+ * eg. EasyScheduler<4> scheduler;
+ *
+ * Register tasks in the setup, in priority order. A period of 0 runs the task
+ * on every pass. The deadline is how late a task may start before it is
+ * counted as a miss; 0 means the task has no deadline.
+ * eg. scheduler.addTask(readTrigger, 1000, 1000, F("trigger"));
+ *
+ * Run the due tasks from the main loop:
+ * eg. scheduler.run();
+ *
+ * The next start time of a task is always the previous start time plus the
+ * period, so tasks do not drift. If a task falls more than a whole period
+ * behind, the missed runs are skipped rather than run back to back.
+ *
+ * A task can be stopped, and started again with a new period. The first run is
+ * one period after the start, eg. the follow-up shots of a burst:
+ * eg. scheduler.startTask(cycleTask, 100000);
+ *     scheduler.stopTask(cycleTask);
+ *
+ * The scheduler records the worst-case execution time and the number of missed
+ * deadlines per task. Use printStats() to write them to the debug log, a task
+ * at a time.
+ */
+template <uint8_t MAX_TASKS>
+class EasyScheduler {
+private:
+  struct task {
+    task_function function;
+    const __FlashStringHelper* name;
+    unsigned long period;          // us between runs
+    unsigned long nextRun;         // us when the task is next due
+    unsigned long worstCase;       // longest execution time in us
+    uint16_t deadline;             // us a task may start late
+    uint16_t misses;               // number of late starts
+    bool running;                  // stopped tasks are skipped
+  };
+
+  task _tasks[MAX_TASKS];
+  uint8_t _taskCount = 0;
+  volatile int8_t _current = -1;                      // the task running, read by interrupts
+  const __FlashStringHelper* _slowest = NULL;         // the task that took longest in the last run()
+
+public:
+  EasyScheduler() {}
+
+  /**
+   * Registers a task. Returns the task id, or -1 when all slots are in use.
+   */
+  int8_t addTask(task_function function, unsigned long period, uint16_t deadline, const __FlashStringHelper* name) {
+    if (_taskCount >= MAX_TASKS || !function)
+      return -1;
+    task& t = _tasks[_taskCount];
+    t.function = function;
+    t.name = name;
+    t.period = period;
+    t.nextRun = micros() + period;
+    t.worstCase = 0;
+    t.deadline = deadline;
+    t.misses = 0;
+    t.running = true;
+    return _taskCount++;
+  }
+
+  /**
+   * Starts a task with a new period, the first run is one period from now.
+   */
+  void startTask(uint8_t id, unsigned long period) {
+    if (id >= _taskCount) return;
+    task& t = _tasks[id];
+    t.period = period;
+    t.nextRun = micros() + period;
+    t.running = true;
+  }
+
+  /**
+   * Changes the period of a task, from its next run on. The runs stay anchored
+   * to the last start, so the change does not add any drift.
+   */
+  void setPeriod(uint8_t id, unsigned long period) {
+    if (id >= _taskCount) return;
+    task& t = _tasks[id];
+    t.nextRun += period - t.period;
+    t.period = period;
+  }
+
+  /**
+   * Stops a task until it is started again.
+   */
+  void stopTask(uint8_t id) {
+    if (id < _taskCount)
+      _tasks[id].running = false;
+  }
+
+  bool isRunning(uint8_t id) {
+    return (id < _taskCount) && _tasks[id].running;
+  }
+
+  /**
+   * Runs every task that is due, in the order they were added.
+   * This should be the only call in the main loop.
+   */
+  void run() {
+    unsigned long slowest = 0;
+    _slowest = NULL;
+    for (uint8_t i = 0; i < _taskCount; i++) {
+      task& t = _tasks[i];
+      if (!t.running)
+        continue;
+      unsigned long start = micros();
+      unsigned long late = start - t.nextRun;
+      if ((long)late < 0)
+        continue;
+
+      if (t.deadline > 0 && late > t.deadline)
+        t.misses++;
+
+      _current = i;
+      t.function();
+      _current = -1;
+
+      unsigned long elapsed = micros() - start;
+      if (elapsed > t.worstCase)
+        t.worstCase = elapsed;
+      if (elapsed >= slowest) {
+        slowest = elapsed;
+        _slowest = t.name;
+      }
+
+      if (t.period == 0 || late >= t.period) {
+        t.nextRun = start + t.period;      // fell behind, skip the missed runs
+      } else {
+        t.nextRun += t.period;
+      }
+    }
+  }
+
+  /**
+   * Returns the longest execution time of a task in us.
+   */
+  unsigned long getWorstCase(uint8_t id) {
+    return (id < _taskCount) ? _tasks[id].worstCase : 0;
+  }
+
+  /**
+   * Returns the number of times a task started after its deadline.
+   */
+  uint16_t getMisses(uint8_t id) {
+    return (id < _taskCount) ? _tasks[id].misses : 0;
+  }
+
+  /**
+   * Clears the worst-case and missed deadline counters of all tasks.
+   */
+  void resetStats() {
+    for (uint8_t i = 0; i < _taskCount; i++) {
+      _tasks[i].worstCase = 0;
+      _tasks[i].misses = 0;
+    }
+  }
+
+  uint8_t getTaskCount() {
+    return _taskCount;
+  }
+
+  /**
+   * Returns the name of the task that is running, or NULL between tasks. Safe to
+   * call from an interrupt, eg. to find where the loop hung.
+   */
+  const __FlashStringHelper* getCurrentTask() {
+    int8_t id = _current;
+    return (id >= 0) ? _tasks[id].name : NULL;
+  }
+
+  /**
+   * Returns the name of the task that took longest in the last run(), or NULL
+   * when no task was due.
+   */
+  const __FlashStringHelper* getSlowestTask() {
+    return _slowest;
+  }
+
+  /**
+   * Prints the period, worst-case execution time and missed deadlines of a task
+   * on one line.
+   */
+  void printStats(Print& out, uint8_t id) {
+    if (id >= _taskCount) return;
+    task& t = _tasks[id];
+    out.print(t.name);
+    out.print(F(": period="));
+    out.print(t.period);
+    out.print(F("us wcet="));
+    out.print(t.worstCase);
+    out.print(F("us missed="));
+    out.println(t.misses);
+  }
+};
+
+#endif
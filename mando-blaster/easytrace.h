@@ -0,0 +1,184 @@
+#ifndef easytrace_h
+#define easytrace_h
+
+#include <Arduino.h>
+
+namespace easytrace {
+  // record types, the param of each is in brackets
+  static const uint8_t EPOCH   = 0;    // the time holds millis() >> 16 for the records after it
+  static const uint8_t BOOT    = 1;    // setup ran
+  static const uint8_t BUTTON  = 2;    // trigger edge (1 pressed, 0 released), at the edge time
+  static const uint8_t SHOT    = 3;    // counter ticked (count left)
+  static const uint8_t DRY     = 4;    // pulled on an empty clip
+  static const uint8_t AUDIO   = 5;    // play command sent to the player (track)
+  static const uint8_t LED     = 6;    // blaster shot phase changed (phase, see ezPattern)
+  static const uint8_t MODE    = 7;    // ammo mode loaded (row)
+  static const uint8_t HEAT    = 8;    // barrel overheated (1) or cooled down (0)
+  static const uint8_t STATE   = 9;    // blaster state at a trigger pull (ammo mode, +128 when
+                                       // overheated), the time holds the barrel heat
+}
+
+/**
+ * One trace record, the time is the low 16 bits of millis().
+ */
+struct EasyTraceRecord {
+  uint16_t time;
+  uint8_t type;
+  uint8_t param;
+};
+
+/**
+ * A binary trace of what the blaster did, kept in a RAM ring so the last SIZE
+ * records survive until they are dumped. Recording is a millis() call and four
+ * byte stores, and nothing is sent until the trace is dumped.
+ *
+ * Use the declaration to set the number of records, 4 bytes of RAM each:
+ * eg. EasyTrace<64> trace;
+ *
+ * Record from the main loop, not from an ISR:
+ * eg. trace.record(easytrace::AUDIO, track);
+ * eg. trace.record(easytrace::BUTTON, 1, pressedTime);   // at an earlier time
+ * eg. trace.recordValue(easytrace::STATE, mode, heat);   // at the time of the record before it
+ *
+ * Dump the records, oldest first, as text so a serial monitor can capture them.
+ * printLine() writes one line of the dump, so a task can send a few lines each
+ * pass as the port has room, instead of blocking until the whole dump is out:
+ * eg. if (Serial.availableForWrite() >= 32 && !trace.printLine(Serial, line++)) ... done
+ *   TRACE <millis> <epoch> <records>
+ *   <time> <type> <param>
+ *   ...
+ *   END
+ * The epoch is millis() >> 16 before the first record, EPOCH records move it on.
+ * extras/simulator replays a dump through the sketch and compares the records.
+ */
+template <uint8_t SIZE>
+class EasyTrace {
+private:
+  EasyTraceRecord _records[SIZE];
+  uint8_t _next = 0;            // slot of the next record
+  uint8_t _count = 0;
+  uint16_t _epoch = 0;          // epoch of the last record
+  uint16_t _baseEpoch = 0;      // epoch before the oldest record
+  uint16_t _total = 0;          // records ever written, wraps
+  uint16_t _dumpEnd = 0;        // _total when the dump started
+  uint8_t _dumpCount = 0;       // records in the dump
+
+  void push(uint16_t time, uint8_t type, uint8_t param) {
+    EasyTraceRecord& r = _records[_next];
+    if (_count < SIZE)
+      _count++;
+    else if (r.type == easytrace::EPOCH)
+      _baseEpoch = r.time;      // the oldest epoch marker is overwritten
+    r.time = time;
+    r.type = type;
+    r.param = param;
+    if (++_next == SIZE) _next = 0;
+    _total++;
+  }
+
+public:
+  EasyTrace() {}
+
+  void record(uint8_t type, uint8_t param = 0) {
+    record(type, param, millis());
+  }
+
+  void record(uint8_t type, uint8_t param, unsigned long time) {
+#if ENABLE_EASY_TRACE == 1
+    uint16_t epoch = time >> 16;
+    if (epoch != _epoch) {
+      _epoch = epoch;
+      push(epoch, easytrace::EPOCH, 0);
+    }
+    push((uint16_t)time, type, param);
+#endif
+  }
+
+  /**
+   * Records a value in place of the time, it takes the time of the record before it.
+   */
+  void recordValue(uint8_t type, uint8_t param, uint16_t value) {
+#if ENABLE_EASY_TRACE == 1
+    push(value, type, param);
+#endif
+  }
+
+  uint8_t size() {
+    return _count;
+  }
+
+  /**
+   * Returns a running count of records written, wraps at 65535.
+   */
+  uint16_t getTotal() {
+    return _total;
+  }
+
+  uint16_t getBaseEpoch() {
+    return _baseEpoch;
+  }
+
+  /**
+   * Copies a record, 0 is the oldest. Returns False when there is none.
+   */
+  bool get(uint8_t i, EasyTraceRecord& r) {
+    if (i >= _count) return false;
+    uint16_t slot = (uint16_t)_next + SIZE - _count + i;
+    r = _records[slot % SIZE];
+    return true;
+  }
+
+  /**
+   * Writes line n of the dump, see above. Line 0 takes the records there are now,
+   * and the lines after it write them one at a time. A record that is written over
+   * before its line is sent is left out. Returns False when there is no line n,
+   * after the END line.
+   */
+  bool printLine(Print& out, uint16_t n) {
+    if (n == 0) {
+      _dumpEnd = _total;
+      _dumpCount = _count;
+      out.print(F("TRACE "));
+      out.print(millis());
+      out.print(' ');
+      out.print(_baseEpoch);
+      out.print(' ');
+      out.println(_count);
+      return true;
+    }
+    if (n <= _dumpCount) {
+      // the records after the dump started have moved it along the ring
+      uint16_t age = (uint16_t)(_total - _dumpEnd) + _dumpCount - (n - 1);
+      EasyTraceRecord r;
+      if (age <= _count && get(_count - age, r)) {
+        out.print(r.time);
+        out.print(' ');
+        out.print(r.type);
+        out.print(' ');
+        out.println(r.param);
+      }
+      return true;
+    }
+    if (n == _dumpCount + 1) {
+      out.println(F("END"));
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Writes the whole dump. This blocks while it prints, about 60ms for 64 records
+   * at 115200 baud, see printLine().
+   */
+  void dump(Print& out) {
+    for (uint16_t n = 0; printLine(out, n); n++);
+  }
+
+  void clear() {
+    _count = 0;
+    _next = 0;
+    _baseEpoch = _epoch;
+  }
+};
+
+#endif
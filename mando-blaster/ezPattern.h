@@ -16,33 +16,69 @@ typedef void (*callback_function)(void); // type for conciseness
  *  A pattern is passed to an EasyLedv3 to control the LED set.
  *  e.g. leds.activate(hotshot);
  *
+ *  Each pattern keeps its own frame timer, so patterns on different strips can
+ *  animate at their own rates. Frames are scheduled from the previous deadline,
+ *  not from when the frame ran, so they do not drift. After a stall up to
+ *  MAX_CATCH_UP_FRAMES missed frames are run back to back, any more are dropped.
+ *
+ *  There are no virtual functions. A pattern class derives from ezPattern for the
+ *  frame timer and the pixel helpers, and has its own activate() and updateDisplay().
+ *  The led classes take the pattern class as a template parameter and call it
+ *  directly, any instance of it can be activated at run time:
+ *  e.g. EasyLedv3<8, 6, ezBlasterShot> leds;
+ *
+ *  Patterns only change pixels, they never call FastLED.show(). A pattern marks
+ *  itself dirty when a pixel actually changed, and the EasyLedv3 pushes the frame
+ *  out once per loop from commit().
+ *
  *  REQUIRED LIBRARY: FastLED
  */
 
 /**
- *  Interface for building different LED patterns and behaviours
+ *  Base for building different LED patterns and behaviours
  */
 class ezPattern {
   protected:
     callback_function _callbackPtr = 0;     // pointer to callback function
     volatile uint8_t _activated    = 0;     // signal when the pattern should be active
+    bool _dirty                    = false; // pixels changed since the last commit
 
     uint8_t _frameRate             = 16;    // larger number is a slower fade
+    unsigned long _nextFrame       = 0;     // time the next frame is due
     unsigned long _flashTimer      = 0;     // time when the white flash started
 
     uint8_t _flashDuration              = 50;    // larger number will hold a white flash longer
     static const uint8_t _delta         = 1;     // Sets forward or backwards direction amount.
     static const uint8_t _fadeRate      = 220;   // How fast to fade out tail. [0-255]
 
+    static const uint8_t MAX_CATCH_UP_FRAMES = 3;   // frames run back to back after a stall
+
     // fucntion declartions
-    void show() {
-#if ENABLE_EASY_LED == 1
-      FastLED.show();
-#endif
+    /**
+     *  Start the frame timer, the first frame is due one period from now.
+     */
+    void startFrames() {
+      _nextFrame = millis() + _frameRate;
+    }
+    /**
+     *  Returns the number of frames that are due, and moves the deadline past them.
+     *  When more than MAX_CATCH_UP_FRAMES are late the rest are dropped, and the
+     *  timer restarts from now.
+     */
+    uint8_t framesDue() {
+      unsigned long now = millis();
+      if ((long)(now - _nextFrame) < 0) return 0;
+      unsigned long due = (now - _nextFrame) / _frameRate + 1;
+      if (due > MAX_CATCH_UP_FRAMES) {
+        _nextFrame = now + _frameRate;
+        return MAX_CATCH_UP_FRAMES;
+      }
+      _nextFrame += due * _frameRate;
+      return due;
     }
     void clear(CRGB *leds, uint8_t count) {
 #if ENABLE_EASY_LED == 1
-      fill_solid(leds, count, CRGB::Black);
+      fill(leds, count, CRGB::Black);
 #endif
     }
     void completed(struct CRGB *leds, uint8_t count) {
@@ -54,28 +90,57 @@ class ezPattern {
     void whiteflash(CRGB *leds, int count) {
 #if ENABLE_EASY_LED == 1
       _flashTimer = millis(); // capture the time for timing the flash
-      fill_solid(leds, count, CRGB::White);
-      show();
+      fill(leds, count, CRGB::White);
 #endif
     }
+    // only touches the leds, and marks the frame dirty, when a pixel changes
     void fill(CRGB *leds, int count, CRGB color) {
 #if ENABLE_EASY_LED == 1
-      fill_solid(leds, count, color);
-      show();
+      for (int i = 0; i < count; i++) {
+        if (leds[i] != color) {
+          fill_solid(leds, count, color);
+          _dirty = true;
+          return;
+        }
+      }
 #endif
     }
     void fadeToBlack(CRGB *leds, int count) {
 #if ENABLE_EASY_LED == 1
-      fadeToBlackBy(leds, count, _fadeRate);
+      for (int i = 0; i < count; i++) {
+        if (leds[i]) {
+          fadeToBlackBy(leds, count, _fadeRate);
+          _dirty = true;
+          return;
+        }
+      }
 #endif
     }
   public:
     bool isActivated(void) volatile {
       return _activated > 0;
     }
-    virtual void activate(CRGB *leds, uint8_t count) = 0;
-    virtual bool updateDisplay(CRGB *leds, uint8_t count) = 0;
-    virtual ~ezPattern() = default;
+    /**
+     *  Returns the phase of the pattern, 0 when it is off. The blaster shot is 3
+     *  while the white flash holds and 2 while the color fades.
+     */
+    uint8_t getPhase(void) volatile {
+      return _activated;
+    }
+    /**
+     *  Set the time between frames in ms, eg. 30 for ~33 frames per second.
+     */
+    void setFrameRate(uint8_t ms) {
+      _frameRate = max(ms, 1);
+    }
+    /**
+     *  Returns True if the pattern changed a pixel since the last call.
+     */
+    bool takeDirty(void) {
+      bool dirty = _dirty;
+      _dirty = false;
+      return dirty;
+    }
 };
 
 /**
@@ -83,81 +148,110 @@ class ezPattern {
  *  1. Flash White
  *  2. Starting color with fade to secondary color
  *  3. fade to black to show cooling
+ *
+ *  The colors for steps 2 and 3 are worked out once in initialize() and stored
+ *  in a table, so each frame only copies the next color to the leds.
+ *  The default CURVE_LINEAR steps each channel evenly, CURVE_EASE_OUT starts
+ *  fast and slows down towards each color. Both use the same number of frames.
+ *  eg. ezBlasterShot hotshot(CRGB::Red, CRGB::Orange, 6, 0, ezBlasterShot::CURVE_EASE_OUT);
+ *
+ *  The table holds MAX_FADE_FRAMES colors, 96 bytes of RAM for each ezBlasterShot.
+ *  A fade takes about 2 * speed + 1 frames, so a speed above 15 is cut short: the
+ *  frames past MAX_FADE_FRAMES are left out, and the last frame is always black.
  */
 class ezBlasterShot : public ezPattern
 {
+  public:
+    static const uint8_t CURVE_LINEAR    = 0;
+    static const uint8_t CURVE_EASE_OUT  = 1;
+    static const uint8_t MAX_FADE_FRAMES = 32;   // 3 bytes of RAM each
+
   protected:
-    CRGB _currentColor;  // color
     CRGB _startColor;    // starting color
     CRGB _targetColor;   // target color
     const CRGB _coolOffColor = CRGB::Black;
 
+    // precomputed fade
+    CRGB _fade[MAX_FADE_FRAMES];
+    uint8_t _fadeFrames    = 0;   // number of colors in the table
+    uint8_t _fadeIndex     = 0;   // next color to show
+    uint8_t _curve         = CURVE_LINEAR;
+
     // processing variables
-    uint8_t _blendRate     = 32;  // larger number will be a faster color blend
-    uint8_t _blendSteps    = 1;   // larger number will be a slower color blend
+    uint8_t _blendSteps    = 1;   // larger number will be a slower color blend, up to 15 fits the table
 
-    uint8_t calcBlendRate(CRGB& cur, const CRGB& target) {
+    uint8_t calcBlendRate(const CRGB& cur, const CRGB& target) {
       uint8_t red = delta(cur.red, target.red) / _blendSteps;
       uint8_t green = delta(cur.green, target.green) / _blendSteps;
       uint8_t blue = delta(cur.blue, target.blue) / _blendSteps;
-      return max(red, max(green, blue));
+      return max(max(red, max(green, blue)), 1);   // always make progress
     }
 
     inline uint8_t delta(uint8_t a, uint8_t b) {
       return (a < b) ? b - a : a - b;
     }
 
-    // helper functions
-    bool checkShotCooled(CRGB *leds, uint8_t count) {
-      if ((_activated == 1) && (_currentColor == _coolOffColor)) {
-        _activated = 0;
-        this->completed(leds, count);
-        this->show();
-        return true;
-      }
-      return false;
+    /**
+     *  Fill the table with: the blend to the target color, a frame holding the
+     *  target, then the cool down to black.
+     */
+    void buildFade() {
+      _fadeFrames = 0;
+      addFadeSegment(_startColor, _targetColor, calcBlendRate(_startColor, _targetColor));
+      addFadeFrame(_targetColor);
+      // the cooling rate is taken from the starting color
+      addFadeSegment(_targetColor, _coolOffColor, calcBlendRate(_startColor, _coolOffColor));
+      _fade[_fadeFrames - 1] = _coolOffColor;
     }
 
-    bool checkShotBlended(CRGB *leds, uint8_t count) {
-      if ((_activated == 2) && (_currentColor == _targetColor)) {
-        // on match, we set to target to black to fade out
-        _activated = 1;    // phase 2
-        _blendRate = calcBlendRate(_startColor, _coolOffColor);    // reset blend rate
-        return true;
+    void addFadeSegment(const CRGB& from, const CRGB& to, uint8_t rate) {
+      // count the linear steps, so every curve takes the same time
+      uint8_t steps = 0;
+      for (CRGB color = from; color != to; steps++)
+        fadeTowardColor(color, to, rate);
+
+      CRGB color = from;
+      for (uint8_t i = 1; i <= steps; i++) {
+        if (_curve == CURVE_EASE_OUT) {
+          uint8_t remaining = 255 - (uint16_t)i * 255 / steps;
+          color = blend(from, to, 255 - scale8(remaining, remaining));
+          if (i == steps) color = to;
+        } else {
+          fadeTowardColor(color, to, rate);
+        }
+        addFadeFrame(color);
       }
-      return false;
     }
 
-    bool coolingShot(CRGB *leds, uint8_t count) {
-      if (_activated == 1) {
-        fadeTowardColor(_currentColor, _coolOffColor, _blendRate);
-        this->fill(leds, count, _currentColor);
+    void addFadeFrame(const CRGB& color) {
+      if (_fadeFrames < MAX_FADE_FRAMES)
+        _fade[_fadeFrames++] = color;
+    }
+
+    // helper functions
+    bool checkShotCooled(CRGB *leds, uint8_t count) {
+      if ((_activated == 2) && (_fadeIndex >= _fadeFrames)) {
+        _activated = 0;
+        this->completed(leds, count);
         return true;
       }
       return false;
     }
 
-    bool blendingShot(CRGB *leds, uint8_t count) {
+    bool fadingShot(CRGB *leds, uint8_t count) {
       if (_activated == 2) {
-        fadeTowardColor(_currentColor, _targetColor, _blendRate);
-        this->fill(leds, count, _currentColor);
+        this->fill(leds, count, _fade[_fadeIndex++]);
         return true;
       }
       return false;
     }
 
     bool checkWhiteFlash(CRGB *leds, uint8_t count) {
-      if (_activated == 4) {
-        this->whiteflash(leds, count);
-        _currentColor = CRGB(_startColor.r, _startColor.g, _startColor.b);
-        _activated = 3;   // hold the flash
-        return true;
-      }
       if (_activated == 3) {
         long duration = millis() - _flashTimer;
         if (duration > _flashDuration) {
           _activated = 2;   // start the fade
-          _blendRate = calcBlendRate(_startColor, _targetColor);    // reset blend rate
+          _fadeIndex = 0;
         }
         return true;
       }
@@ -203,11 +297,12 @@ class ezBlasterShot : public ezPattern
     }
 
   public:
-    ezBlasterShot(CRGB initialColor, CRGB endColor, uint8_t speed = 6, callback_function callback = 0) {
-      initialize(initialColor, endColor);
+    ezBlasterShot(CRGB initialColor, CRGB endColor, uint8_t speed = 6, callback_function callback = 0, uint8_t curve = CURVE_LINEAR) {
       _frameRate = 30;
       _callbackPtr = callback;
       _blendSteps = max (speed, 1);
+      _curve = curve;
+      initialize(initialColor, endColor);
     }
     ~ezBlasterShot() {
       _callbackPtr = 0;
@@ -216,42 +311,63 @@ class ezBlasterShot : public ezPattern
     void initialize(CRGB initialColor, CRGB endColor) {
       _startColor = CRGB(initialColor.r, initialColor.g, initialColor.b);
       _targetColor = CRGB(endColor.r, endColor.g, endColor.b);
+      buildFade();
+    }
+
+    /**
+     *  Change the colors, blend steps and curve, with a single rebuild of the fade.
+     *  eg. hotshot.initialize(CRGB::Yellow, CRGB::White, 6, ezBlasterShot::CURVE_LINEAR);
+     */
+    void initialize(CRGB initialColor, CRGB endColor, uint8_t speed, uint8_t curve) {
+      _blendSteps = max(speed, 1);
+      _curve = curve;
+      initialize(initialColor, endColor);
+    }
+
+    /**
+     *  Change the fade curve, eg. setCurve(ezBlasterShot::CURVE_EASE_OUT);
+     */
+    void setCurve(uint8_t curve) {
+      _curve = curve;
+      buildFade();
     }
 
     void activate(CRGB *leds, uint8_t count) {
-      //DBGLN(F("BlasterShot - activated"));
+      PROFILE_SCOPE(easyprofile::SHOT_FLASH);
+      LOG(LED, DEBUG, F("BlasterShot - activated"));
       _activated = 3;    // start with white flash and color fade
-      //reset the current color to the start
-      _currentColor = CRGB(_startColor.r, _startColor.g, _startColor.b);
       this->whiteflash(leds, count);
+      startFrames();
     }
 
     bool updateDisplay(CRGB *leds, uint8_t count) {
-      EVERY_N_MILLISECONDS(_frameRate) {
-        // stop fading and clear
-        if (checkShotCooled(leds, count)) {
-          //DBGLN(F("BlasterShot - ending blaster shot"));
-          return true;
-        }
-        // fade to black
-        if (checkShotBlended(leds, count)) {
-          //DBGLN(F("BlasterShot - fade to black on blaster shot"));
-          return true;
-        }
-        if (coolingShot(leds, count)) {
-          //DBGLN(F("BlasterShot - Cooling off blaster shot"));
-          return true;
-        }
-        if (blendingShot(leds, count)) {
-          //DBGLN(F("BlasterShot - blending colors on blaster shot"));
-          return true;
-        }
-        if (checkWhiteFlash(leds, count)) {
-          //DBGLN(F("BlasterShot - checking white flash"));
-          return true;
-        }
+      if (_activated == 0) return false;
+      bool updated = false;
+      for (uint8_t frames = framesDue(); frames > 0 && _activated > 0; frames--) {
+        if (updateFrame(leds, count))
+          updated = true;
       }
-      return _activated > 0;
+      return updated || _activated > 0;
+    }
+
+  protected:
+    // advance the shot by a single frame
+    bool updateFrame(CRGB *leds, uint8_t count) {
+      PROFILE_SCOPE(_activated == 3 ? easyprofile::SHOT_FLASH : easyprofile::SHOT_FADE);
+      // stop fading and clear
+      if (checkShotCooled(leds, count)) {
+        LOG(LED, DEBUG, F("BlasterShot - ending blaster shot"));
+        return true;
+      }
+      if (fadingShot(leds, count)) {
+        LOG(LED, DEBUG, F("BlasterShot - fading blaster shot"));
+        return true;
+      }
+      if (checkWhiteFlash(leds, count)) {
+        LOG(LED, DEBUG, F("BlasterShot - checking white flash"));
+        return true;
+      }
+      return false;
     }
 };
 
@@ -0,0 +1,784 @@
+#ifndef pcm_sounds_h
+#define pcm_sounds_h
+
+/**
+ * Sound effects for the PCM audio back end, signed 8 bit mono at 8kHz.
+ * Generated by extras/pcm_sounds/make_sounds.py - DO NOT EDIT
+ */
+
+// start_up - rising power up sweep, 350 ms
+static const int8_t PCM_START_UP[] PROGMEM = {
+  0, 1, 3, 6, 9, 13, 17, 21, 25, 28, 31, 33, 34, 33, 31, 27,
+  22, 16, 8, -1, -11, -22, -33, -44, -55, -65, -74, -81, -87, -91, -92, -90,
+  -86, -79, -70, -58, -43, -27, -9, 11, 31, 50, 67, 83, 97, 108, 116, 122,
+  124, 122, 118, 110, 100, 87, 71, 54, 35, 15, -5, -25, -44, -62, -79, -93,
+  -105, -114, -120, -122, -122, -118, -111, -100, -87, -72, -55, -36, -16, 4, 24, 43,
+  62, 78, 92, 104, 113, 119, 121, 120, 116, 108, 98, 84, 69, 51, 32, 12,
+  -8, -28, -47, -65, -81, -95, -106, -114, -119, -120, -118, -112, -104, -92, -78, -61,
+  -43, -23, -3, 17, 37, 56, 73, 88, 100, 110, 116, 119, 118, 114, 106, 96,
+  82, 66, 48, 29, 9, -12, -32, -51, -68, -84, -97, -107, -114, -117, -117, -114,
+  -107, -96, -83, -67, -50, -30, -10, 10, 31, 50, 67, 83, 96, 106, 113, 116,
+  116, 112, 105, 94, 81, 64, 46, 27, 7, -14, -34, -53, -70, -86, -98, -107,
+  -113, -115, -114, -109, -101, -89, -74, -58, -39, -19, 2, 22, 42, 60, 77, 91,
+  102, 110, 114, 114, 111, 104, 94, 80, 64, 46, 27, 6, -15, -35, -54, -71,
+  -86, -98, -107, -112, -113, -111, -105, -95, -83, -67, -49, -30, -10, 11, 32, 51,
+  68, 84, 96, 105, 111, 112, 110, 104, 95, 82, 67, 49, 29, 9, -12, -32,
+  -52, -69, -84, -96, -105, -110, -111, -109, -102, -92, -79, -62, -44, -24, -4, 17,
+  37, 56, 73, 87, 99, 106, 110, 110, 106, 98, 86, 72, 55, 36, 15, -6,
+  -27, -46, -64, -80, -93, -102, -108, -109, -107, -101, -91, -77, -61, -43, -23, -2,
+  19, 39, 58, 75, 88, 99, 106, 108, 107, 102, 92, 80, 64, 46, 26, 5,
+  -16, -36, -55, -72, -86, -97, -104, -107, -106, -101, -92, -80, -64, -46, -26, -5,
+  16, 37, 56, 73, 87, 97, 104, 107, 105, 99, 90, 77, 60, 42, 22, 1,
+  -21, -41, -59, -76, -89, -98, -104, -106, -103, -96, -85, -71, -54, -34, -14, 7,
+  28, 48, 66, 81, 93, 101, 104, 104, 99, 90, 78, 62, 43, 23, 2, -19,
+  -40, -58, -75, -88, -97, -103, -104, -101, -93, -81, -67, -49, -29, -8, 13, 34,
+  53, 70, 84, 95, 101, 103, 101, 94, 83, 68, 51, 31, 10, -11, -32, -51,
+  -69, -83, -94, -100, -102, -100, -93, -82, -68, -50, -30, -9, 12, 33, 52, 70,
+  84, 94, 100, 101, 98, 91, 79, 64, 46, 26, 5, -17, -37, -56, -73, -86,
+  -95, -100, -100, -96, -87, -74, -58, -39, -19, 3, 24, 45, 63, 78, 90, 97,
+  100, 98, 92, 81, 66, 49, 29, 7, -14, -35, -54, -71, -84, -94, -98, -99,
+  -94, -85, -72, -55, -36, -15, 7, 28, 48, 66, 80, 91, 97, 98, 95, 87,
+  74, 58, 39, 19, -3, -25, -45, -63, -78, -89, -96, -98, -95, -87, -75, -59,
+  -40, -20, 2, 24, 44, 62, 77, 88, 95, 97, 94, 86, 74, 58, 39, 18,
+  -4, -26, -46, -64, -79, -89, -95, -96, -92, -83, -70, -53, -34, -13, 9, 31,
+  51, 68, 81, 91, 95, 95, 89, 79, 64, 46, 26, 4, -17, -38, -57, -73,
+  -85, -92, -95, -92, -84, -72, -56, -37, -15, 7, 28, 48, 66, 80, 89, 94,
+  93, 87, 77, 62, 44, 23, 1, -20, -41, -60, -75, -86, -92, -93, -89, -80,
+  -66, -49, -29, -7, 15, 37, 56, 72, 84, 91, 93, 89, 81, 68, 51, 31,
+  9, -13, -34, -54, -70, -82, -90, -92, -89, -81, -68, -51, -31, -9, 13, 34,
+  54, 70, 82, 90, 91, 88, 79, 66, 49, 28, 6, -16, -37, -56, -72, -83,
+  -90, -91, -86, -76, -62, -44, -23, -1, 21, 42, 60, 75, 85, 90, 89, 83,
+  72, 56, 37, 15, -7, -29, -49, -66, -79, -87, -90, -87, -78, -65, -47, -27,
+  -5, 18, 39, 58, 73, 83, 89, 88, 82, 71, 55, 35, 14, -9, -31, -51,
+  -67, -80, -87, -88, -84, -75, -60, -42, -21, 2, 24, 45, 63, 76, 85, 88,
+  85, 77, 63, 46, 25, 3, -20, -41, -59, -74, -83, -87, -85, -78, -65, -47,
+  -27, -5, 18, 39, 58, 73, 83, 87, 85, 77, 64, 47, 27, 4, -18, -40,
+  -58, -73, -82, -86, -84, -76, -63, -45, -24, -2, 21, 42, 60, 74, 83, 86,
+  82, 73, 59, 41, 19, -3, -26, -46, -64, -76, -84, -85, -80, -69, -54, -34,
+  -12, 11, 33, 52, 68, 79, 84, 83, 76, 63, 46, 25, 3, -20, -41, -60,
+  -73, -82, -84, -80, -70, -55, -36, -14, 9, 31, 51, 67, 78, 83, 82, 75,
+  62, 44, 23, 0, -23, -44, -61, -74, -82, -83, -77, -66, -50, -29, -7, 16,
+  38, 57, 71, 80, 83, 79, 69, 53, 34, 12, -11, -33, -53, -68, -78, -82,
+  -79, -70, -56, -37, -15, 9, 31, 51, 67, 77, 82, 79, 71, 56, 37, 15,
+  -8, -30, -50, -66, -77, -81, -79, -70, -55, -36, -14, 9, 31, 51, 67, 77,
+  81, 78, 68, 53, 33, 11, -12, -35, -54, -69, -78, -80, -76, -65, -49, -29,
+  -6, 17, 39, 58, 71, 78, 79, 73, 61, 43, 22, -1, -24, -45, -62, -74,
+  -79, -77, -69, -54, -35, -13, 10, 33, 53, 67, 76, 79, 74, 63, 46, 25,
+  2, -21, -43, -60, -72, -78, -77, -68, -54, -35, -13, 11, 33, 53, 68, 76,
+  78, 72, 60, 43, 21, -2, -25, -46, -63, -73, -77, -74, -64, -48, -28, -5,
+  19, 40, 58, 71, 77, 75, 67, 52, 33, 10, -14, -36, -55, -68, -76, -76,
+  -69, -55, -36, -14, 10, 33, 52, 67, 75, 76, 69, 56, 37, 15, -8, -31,
+  -51, -66, -74, -75, -69, -56, -38, -15, 8, 31, 51, 66, 74, 75, 68, 55,
+  36, 14, -10, -33, -52, -67, -74, -74, -67, -53, -33, -10, 13, 36, 55, 68,
+  74, 73, 64, 49, 29, 5, -18, -40, -58, -70, -74, -71, -61, -44, -22, 1,
+  25, 46, 62, 72, 74, 68, 55, 37, 14, -10, -33, -52, -66, -73, -72, -64,
+  -48, -28, -4, 19, 41, 59, 70, 73, 69, 57, 39, 17, -7, -30, -50, -65,
+  -72, -71, -63, -48, -27, -4, 20, 42, 59, 69, 72, 67, 55, 36, 13, -11,
+  -34, -53, -66, -72, -70, -59, -43, -21, 3, 26, 47, 62, 71, 71, 63, 48,
+  27, 4, -20, -42, -59, -69, -71, -65, -51, -32, -9, 16, 38, 56, 67, 71,
+  66, 54, 35, 12, -12, -35, -54, -66, -71, -67, -55, -37, -14, 10, 33, 52,
+  65, 70, 67, 55, 37, 15, -9, -33, -52, -65, -70, -66, -55, -37, -14, 10,
+  33, 52, 65, 70, 66, 54, 35, 12, -12, -35, -54, -66, -69, -64, -51, -32,
+  -8, 16, 38, 56, 66, 69, 62, 48, 27, 4, -21, -42, -59, -67, -68, -59,
+  -43, -21, 3, 27, 47, 62, 68, 66, 55, 37, 14, -11, -34, -53, -64, -68,
+  -63, -49, -29, -5, 19, 41, 58, 67, 67, 58, 41, 19, -5, -29, -49, -62,
+  -67, -63, -51, -31, -8, 17, 39, 56, 66, 66, 58, 41, 19, -5, -29, -49,
+  -62, -67, -62, -49, -29, -5, 19, 41, 57, 66, 65, 55, 37, 15, -10, -34,
+  -52, -64, -66, -59, -44, -22, 2, 26, 47, 61, 66, 62, 49, 29, 5, -20,
+  -42, -58, -65, -63, -52, -34, -10, 15, 37, 55, 64, 64, 55, 37, 15, -10,
+  -34, -52, -63, -64, -56, -40, -18, 7, 31, 50, 62, 64, 57, 42, 20, -5,
+  -29, -49, -61, -64, -58, -42, -21, 4, 28, 48, 61, 64, 57, 42, 20, -5,
+  -29, -48, -61, -64, -57, -41, -19, 6, 30, 49, 61, 63, 55, 39, 17, -9,
+  -32, -51, -62, -62, -53, -36, -13, 12, 36, 53, 62, 61, 51, 32, 8, -17,
+  -39, -55, -63, -60, -47, -27, -2, 23, 44, 58, 63, 57, 42, 20, -5, -29,
+  -49, -60, -62, -53, -36, -12, 13, 36, 53, 62, 60, 48, 28, 3, -22, -43,
+  -57, -62, -56, -40, -18, 7, 31, 50, 60, 60, 50, 31, 7, -18, -40, -56,
+  -61, -56, -42, -20, 5, 30, 49, 60, 60, 50, 31, 7, -19, -41, -56, -61,
+  -55, -40, -18, 8, 32, 50, 60, 59, 47, 27, 2, -23, -44, -57, -60, -52,
+  -35, -11, 14, 37, 53, 60, 56, 41, 19, -6, -31, -49, -59, -58, -46, -26,
+  -1, 24, 45, 57, 59, 50, 31, 7, -18, -41, -55, -59, -52, -36, -12, 13,
+  37, 53, 59, 54, 39, 16, -9, -33, -51, -59, -55, -41, -20, 6, 30, 49,
+  58, 56, 43, 22, -4, -28, -48, -58, -56, -44, -23, 2, 27, 47, 57, 56,
+  44, 24, -2, -27, -46, -57, -56, -44, -23, 2, 27, 47, 57, 56, 43, 22,
+  -3, -28, -47, -57, -55, -42, -20, 6, 30, 49, 57, 54, 40, 17, -9, -33,
+  -50, -57, -52, -37, -13, 13, 36, 52, 57, 50, 33, 9, -17, -40, -54, -56,
+  -47, -28, -3, 23, 44, 55, 55, 43, 22, -4, -29, -48, -56, -53, -38, -15,
+  11, 35, 51, 56, 49, 31, 7, -19, -41, -54, -55, -44, -23, 3, 28, 47,
+  55, 52, 37, 14, -13, -36, -51, -55, -47, -28, -3, 23, 44, 54, 53, 40,
+  17, -9, -33, -50, -55, -48, -30, -5, 21, 42, 54, 53, 40, 18, -8, -33,
+  -49, -55, -47, -29, -4, 22, 43, 54, 52, 38, 15, -11, -35, -50, -54, -45,
+  -25, 0, 26, 45, 54, 50, 34, 10, -17, -39, -52, -53, -41, -19, 8, 32,
+  49, 54, 46, 26, 1, -25, -45, -53, -49, -33, -9, 18, 40, 52, 51, 38,
+  15, -11, -35, -50, -53, -42, -21, 5, 30, 48, 53, 45, 26, 0, -25, -45,
+  -53, -48, -30, -5, 21, 42, 52, 49, 33, 9, -17, -39, -51, -50, -36, -13,
+  14, 37, 51, 51, 38, 15, -12, -35, -50, -51, -39, -17, 10, 34, 49, 51,
+  40, 18, -9, -33, -49, -51, -40, -18, 8, 33, 48, 51, 40, 18, -9, -33,
+  -48, -51, -39, -17, 9, 34, 49, 50, 38, 16, -11, -35, -49, -50, -37, -14,
+  13, 37, 50, 49, 35, 11, -16, -39, -50, -48, -32, -7, 20, 41, 51, 46,
+  28, 3, -24, -43, -51, -44, -24, 2, 28, 46, 50, 40, 19, -8, -33, -48,
+  -49, -36, -13, 14, 37, 49, 47, 31, 6, -21, -42, -50, -44, -25, 2, 28,
+  45, 50, 39, 17, -10, -34, -48, -48, -33, -8, 19, 40, 49, 44, 25, -1,
+  -27, -45, -49, -38, -16, 11, 35, 48, 46, 30, 5, -22, -42, -49, -41, -21,
+  6, 31, 47, 47, 33, 9, -18, -40, -49, -43, -23, 4, 29, 46, 48, 34,
+  10, -17, -39, -48, -43, -23, 4, 29, 45, 47, 34, 10, -18, -39, -48, -42,
+  -21, 6, 31, 46, 46, 31, 6, -21, -41, -48, -39, -17, 10, 34, 47, 44,
+  27, 1, -26, -44, -47, -35, -11, 17, 39, 48, 40, 20, -7, -32, -46, -44,
+  -28, -2, 25, 43, 47, 34, 10, -17, -39, -47, -39, -18, 10, 34, 46, 43,
+  24, -2, -28, -45, -45, -30, -4, 23, 42, 46, 35, 11, -17, -39, -47, -38,
+  -16, 12, 35, 46, 41, 21, -6, -31, -45, -43, -25, 2, 28, 44, 44, 28,
+  2, -24, -42, -45, -31, -6, 21, 41, 46, 33, 9, -19, -39, -46, -35, -12,
+  16, 38, 46, 36, 14, -14, -37, -46, -37, -15, 13, 36, 45, 38, 16, -12,
+  -35, -45, -38, -17, 11, 35, 45, 38, 17, -11, -35, -45, -38, -16, 12, 35,
+  45, 37, 15, -13, -36, -45, -36, -14, 14, 37, 45, 35, 12, -16, -38, -45,
+  -34, -9, 19, 39, 44, 31, 6, -21, -40, -43, -29, -3, 24, 42, 42, 26,
+  -1, -28, -43, -41, -22, 6, 31, 44, 38, 17, -11, -34, -44, -35, -12, 16,
+  37, 44, 32, 7, -21, -40, -42, -27, 0, 27, 42, 40, 21, -7, -32, -43,
+  -37, -14, 14, 36, 43, 32, 7, -21, -40, -42, -26, 2, 28, 42, 38, 18,
+  -10, -34, -43, -33, -9, 19, 39, 42, 26, 0, -27, -42, -38, -18, 11, 34,
+  43, 32, 8, -20, -39, -41, -24, 3, 29, 42, 36, 14, -15, -37, -42, -28,
+  -2, 25, 41, 38, 18, -10, -34, -42, -31, -6, 22, 40, 39, 21, -7, -32,
+  -42, -32, -8, 20, 39, 40, 22, -6, -31, -42, -33, -8, 20, 39, 39, 21,
+  -7, -32, -42, -32, -7, 21, 39, 39, 19, -9, -33, -41, -30, -4, 24, 40,
+  37, 16, -13, -35, -41, -26, 1, 28, 41, 34, 11, -18, -38, -39, -21, 7,
+  32, 41, 30, 4, -24, -40, -36, -14, 15, 36, 39, 23, -5, -31, -41, -30,
+  -4, 24, 40, 36, 13, -15, -36, -39, -22, 7, 32, 40, 28, 2, -26, -40,
+  -33, -10, 19, 38, 37, 17, -12, -35, -39, -24, 5, 30, 40, 29, 3, -25,
+  -39, -33, -9, 20, 38, 36, 15, -14, -36, -38, -20, 8, 32, 39, 25, -3,
+  -29, -40, -29, -2, 25, 39, 32, 7, -21, -38, -34, -11, 18, 37, 36, 15,
+  -14, -35, -37, -19, 10, 34, 38, 22, -7, -32, -39, -24, 4, 30, 39, 26,
+  -2, -28, -39, -28, -1, 27, 39, 29, 3, -25, -39, -30, -4, 24, 38, 31,
+  5, -23, -38, -31, -6, 22, 38, 31, 7, -22, -38, -32, -7, 22, 38, 31,
+  7, -22, -38, -31, -6, 22, 38, 31, 5, -23, -38, -30, -4, 24, 38, 29,
+  3, -25, -38, -28, -1, 27, 38, 26, -2, -28, -38, -24, 4, 30, 37, 22,
+  -7, -31, -37, -19, 10, 33, 36, 16, -14, -35, -34, -12, 17, 36, 32, 8,
+  -21, -37, -30, -4, 24, 37, 26, -1, -28, -37, -22, 6, 31, 36, 18, -12,
+  -34, -34, -13, 17, 36, 31, 7, -22, -37, -27, 0, 27, 37, 22, -7, -31,
+  -35, -16, 14, 34, 32, 9, -20, -36, -28, -1, 26, 36, 22, -7, -31, -35,
+  -15, 15, 35, 31, 7, -22, -36, -26, 2, 28, 36, 18, -11, -33, -32, -10,
+  20, 36, 27, 0, -27, -36, -19, 10, 33, 32, 10, -20, -36, -26, 1, 28,
+  35, 18, -12, -33, -31, -7, 22, 36, 24, -5, -30, -34, -14, 16, 35, 28,
+  2, -26, -35, -19, 11, 33, 31, 7, -22, -35, -23, 6, 31, 33, 11, -19,
+  -35, -26, 2, 29, 34, 14, -16, -34, -27, 0, 27, 34, 16, -14, -34, -28,
+  -2, 26, 34, 17, -13, -33, -28, -2, 26, 34, 17, -13, -33, -28, -1, 26,
+  34, 15, -15, -34, -27, 1, 28, 33, 13, -17, -34, -25, 4, 29, 32, 10,
+  -20, -34, -22, 8, 31, 30, 6, -23, -34, -18, 12, 33, 27, 0, -27, -33,
+  -12, 18, 34, 23, -7, -31, -30, -5, 24, 33, 16, -14, -33, -25, 3, 29,
+  31, 8, -21, -34, -18, 12, 32, 26, -1, -28, -31, -9, 21, 33, 18, -12,
+  -32, -26, 2, 28, 31, 7, -22, -33, -16, 14, 33, 24, -5, -30, -29, -4,
+  25, 32, 12, -18, -33, -20, 10, 32, 26, -2, -28, -30, -6, 23, 32, 13,
+  -17, -33, -20, 10, 31, 25, -3, -29, -29, -4, 25, 32, 11, -19, -32, -17,
+  14, 32, 22, -8, -30, -26, 2, 28, 29, 4, -24, -31, -10, 20, 32, 15,
+  -16, -32, -20, 11, 31, 23, -6, -30, -26, 1, 27, 29, 4, -25, -30, -8,
+  22, 31, 12, -19, -32, -15, 15, 32, 19, -12, -31, -21, 9, 30, 24, -5,
+  -29, -26, 2, 28, 27, 0, -27, -28, -3, 25, 29, 5, -24, -30, -8, 22,
+  31, 9, -21, -31, -11, 19, 31, 13, -18, -31, -14, 17, 31, 15, -16, -31,
+  -16, 15, 31, 16, -15, -31, -17, 14, 31, 17, -14, -31, -17, 14, 31, 17,
+  -14, -31, -16, 15, 31, 16, -15, -31, -15, 16, 31, 14, -17, -31, -13, 18,
+  30, 12, -19, -30, -11, 20, 30, 9, -21, -29, -7, 23, 29, 5, -24, -28,
+  -2, 25, 27, 0, -27, -25, 3, 28, 23, -6, -29, -21, 9, 30, 19, -12,
+  -30, -16, 16, 30, 12, -19, -29, -8, 22, 28, 4, -24, -27, 0, 27, 24,
+  -5, -28, -21, 9, 29, 17, -14, -30, -13, 18, 29, 8, -22, -27, -2, 25,
+  25, -4, -28, -21, 9, 29, 16, -15, -29, -11, 20, 28, 4, -24, -25, 2,
+  27, 21, -9, -29, -16, 15, 29, 9, -21, -27, -2, 26, 24, -6, -28, -18,
+  13, 29, 11, -20, -28, -3, 25, 24, -5, -28, -18, 13, 29, 11, -20, -27,
+  -2, 26, 23, -7, -28, -16, 16, 28, 7, -23, -25, 3, 27, 19, -12, -29,
+  -11, 20, 26, 1, -26, -21, 10, 28, 13, -19, -27, -2, 25, 22, -9, -28,
+};
+
+// change_mode - two tone chirp, 120 ms
+static const int8_t PCM_CHANGE_MODE[] PROGMEM = {
+  0, 3, 6, 6, 0, -9, -18, -21, -15, 0, 18, 32, 35, 23, 0, -27,
+  -46, -49, -32, 0, 36, 60, 63, 41, 0, -44, -74, -76, -49, 0, 52, 87,
+  89, 57, 0, -60, -99, -102, -64, 0, 68, 109, 109, 67, 0, -67, -108, -107,
+  -66, 0, 66, 106, 106, 65, 0, -65, -105, -105, -65, 0, 64, 104, 103, 64,
+  0, -63, -102, -102, -63, 0, 63, 101, 101, 62, 0, -62, -100, -100, -61, 0,
+  61, 99, 98, 61, 0, -60, -97, -97, -60, 0, 60, 96, 96, 59, 0, -59,
+  -95, -95, -58, 0, 58, 94, 94, 58, 0, -57, -93, -92, -57, 0, 57, 92,
+  91, 56, 0, -56, -90, -90, -56, 0, 55, 89, 89, 55, 0, -55, -88, -88,
+  -54, 0, 54, 87, 87, 54, 0, -53, -86, -86, -53, 0, 53, 85, 85, 52,
+  0, -52, -84, -84, -52, 0, 51, 83, 83, 51, 0, -51, -82, -82, -50, 0,
+  50, 81, 81, 50, 0, -49, -80, -80, -49, 0, 49, 79, 79, 48, 0, -48,
+  -78, -78, -48, 0, 48, 77, 77, 47, 0, -47, -76, -76, -47, 0, 46, 75,
+  75, 46, 0, -46, -74, -74, -46, 0, 45, 73, 73, 45, 0, -45, -72, -72,
+  -44, 0, 44, 71, 71, 44, 0, -44, -70, -70, -43, 0, 43, 70, 69, 43,
+  0, -43, -69, -68, -42, 0, 42, 68, 68, 42, 0, -41, -67, -67, -41, 0,
+  41, 66, 66, 41, 0, -40, -65, -65, -40, 0, 40, 64, 64, 40, 0, -39,
+  -64, -64, -39, 0, 39, 63, 63, 39, 0, -38, -62, -62, -38, 0, 38, 61,
+  61, 38, 0, -38, -61, -60, -37, 0, 37, 60, 60, 37, 0, -37, -59, -59,
+  -36, 0, 36, 58, 58, 36, 0, -36, -58, -57, -35, 0, 35, 57, 57, 35,
+  0, -35, -56, -56, -35, 0, 34, 56, 55, 34, 0, -34, -55, -55, -34, 0,
+  34, 54, 54, 33, 0, -33, -53, -53, -33, 0, 33, 53, 53, 32, 0, -32,
+  -52, -52, -32, 0, 32, 51, 51, 32, 0, -32, -51, -51, -31, 0, 31, 50,
+  50, 31, 0, -31, -50, -49, -31, 0, 30, 49, 49, 30, 0, -30, -48, -48,
+  -30, 0, 30, 48, 48, 29, 0, -29, -47, -47, -29, 0, 29, 47, 46, 29,
+  0, -29, -46, -46, -28, 0, 28, 45, 45, 28, 0, -28, -45, -45, -28, 0,
+  0, 3, 2, -6, -12, -9, 6, 20, 20, 0, -24, -31, -11, 23, 41, 26,
+  -14, -47, -42, 0, 46, 57, 19, -38, -67, -41, 22, 71, 62, 0, -66, -79,
+  -26, 52, 90, 54, -29, -92, -80, 0, 83, 97, 31, -59, -100, -59, 31, 94,
+  79, 0, -79, -92, -30, 56, 95, 56, -29, -89, -75, 0, 75, 87, 28, -53,
+  -90, -53, 28, 84, 71, 0, -71, -83, -27, 50, 85, 50, -26, -80, -68, 0,
+  67, 78, 25, -48, -81, -47, 25, 76, 64, 0, -63, -74, -24, 45, 77, 45,
+  -23, -72, -61, 0, 60, 70, 23, -43, -73, -43, 22, 68, 58, 0, -57, -67,
+  -22, 41, 69, 40, -21, -65, -55, 0, 54, 63, 20, -39, -65, -38, 20, 61,
+  52, 0, -51, -60, -19, 37, 62, 36, -19, -58, -49, 0, 49, 57, 18, -35,
+  -59, -34, 18, 55, 46, 0, -46, -54, -17, 33, 56, 33, -17, -52, -44, 0,
+  44, 51, 16, -31, -53, -31, 16, 49, 42, 0, -41, -48, -16, 30, 50, 29,
+  -15, -47, -40, 0, 39, 46, 15, -28, -47, -28, 14, 44, 38, 0, -37, -43,
+  -14, 27, 45, 26, -14, -42, -36, 0, 35, 41, 13, -25, -43, -25, 13, 40,
+  34, 0, -33, -39, -13, 24, 40, 24, -12, -38, -32, 0, 32, 37, 12, -23,
+  -38, -22, 12, 36, 30, 0, -30, -35, -11, 21, 36, 21, -11, -34, -29, 0,
+  28, 33, 11, -20, -34, -20, 11, 32, 27, 0, -27, -31, -10, 19, 33, 19,
+  -10, -30, -26, 0, 26, 30, 10, -18, -31, -18, 9, 29, 24, 0, -24, -28,
+  -9, 17, 29, 17, -9, -27, -23, 0, 23, 27, 9, -16, -28, -16, 8, 26,
+  22, 0, -22, -25, -8, 16, 26, 15, -8, -25, -21, 0, 21, 24, 8, -15,
+  -25, -15, 8, 23, 20, 0, -20, -23, -7, 14, 24, 14, -7, -22, -19, 0,
+  19, 22, 7, -13, -22, -13, 7, 21, 18, 0, -18, -21, -7, 13, 21, 12,
+  -6, -20, -17, 0, 17, 19, 6, -12, -20, -12, 6, 19, 16, 0, -16, -18,
+  -6, 11, 19, 11, -6, -18, -15, 0, 15, 17, 6, -11, -18, -11, 6, 17,
+  14, 0, -14, -17, -5, 10, 17, 10, -5, -16, -14, 0, 13, 16, 5, -10,
+  -16, -9, 5, 15, 13, 0, -13, -15, -5, 9, 15, 9, -5, -14, -12, 0,
+  12, 14, 5, -9, -15, -9, 4, 14, 12, 0, -11, -13, -4, 8, 14, 8,
+  -4, -13, -11, 0, 11, 13, 4, -8, -13, -8, 4, 12, 10, 0, -10, -12,
+  -4, 7, 12, 7, -4, -12, -10, 0, 10, 11, 4, -7, -12, -7, 4, 11,
+  9, 0, -9, -11, -3, 7, 11, 7, -3, -10, -9, 0, 9, 10, 3, -6,
+  -11, -6, 3, 10, 8, 0, -8, -10, -3, 6, 10, 6, -3, -9, -8, 0,
+  8, 9, 3, -6, -10, -6, 3, 9, 8, 0, -7, -9, -3, 5, 9, 5,
+  -3, -8, -7, 0, 7, 8, 3, -5, -9, -5, 3, 8, 7, 0, -7, -8,
+  -3, 5, 8, 5, -2, -8, -6, 0, 6, 7, 2, -5, -8, -4, 2, 7,
+  6, 0, -6, -7, -2, 4, 7, 4, -2, -7, -6, 0, 6, 7, 2, -4,
+  -7, -4, 2, 6, 5, 0, -5, -6, -2, 4, 7, 4, -2, -6, -5, 0,
+};
+
+// fire_a - falling blaster sweep, 150 ms
+static const int8_t PCM_FIRE_A[] PROGMEM = {
+  0, 1, -7, -6, 7, 9, -12, -20, 0, 33, 3, -28, -27, 22, 27, -10,
+  -54, 5, 60, 24, -44, -38, 20, 75, -11, -61, -38, 51, 60, -63, -55, 10,
+  91, 12, -86, -81, 92, 83, 6, -81, -43, 120, 106, -91, -77, 0, 101, 68,
+  -108, -122, 70, 80, 27, -97, -76, 84, 124, -37, -100, -29, 72, 71, -22, -127,
+  -42, 88, 67, -34, -87, -24, 96, 58, -76, -106, -30, 102, 49, -53, -102, 3,
+  68, 94, -68, -78, 2, 113, 99, -66, -109, -19, 76, 89, -12, -117, -45, 97,
+  77, -40, -84, -61, 68, 70, 5, -74, -69, 37, 111, 26, -80, -98, 29, 112,
+  24, -68, -84, -28, 102, 54, -42, -96, -61, 82, 89, 1, -78, -58, 30, 99,
+  53, -60, -99, -32, 85, 69, 5, -99, -41, 41, 73, 24, -59, -74, -11, 66,
+  53, -17, -78, -33, 42, 80, 46, -53, -73, -32, 87, 69, 0, -99, -85, 4,
+  65, 31, -24, -82, -55, 74, 79, 30, -54, -84, 4, 89, 69, -8, -77, -52,
+  12, 60, 40, -14, -93, -43, 32, 68, 30, -27, -93, -24, 38, 72, 51, -36,
+  -72, -24, 41, 60, 20, -25, -72, -51, 31, 61, 23, -38, -60, -30, 43, 91,
+  20, -25, -70, -47, 47, 63, 43, -34, -88, -28, 16, 68, 53, -29, -85, -60,
+  10, 78, 59, 9, -76, -51, 13, 75, 59, 0, -42, -71, -19, 29, 86, 31,
+  -16, -85, -52, 18, 61, 44, 10, -58, -47, -8, 60, 70, 12, -33, -59, -31,
+  24, 51, 60, 7, -72, -73, -12, 54, 63, 37, -20, -62, -40, 18, 55, 47,
+  19, -55, -53, -26, 38, 71, 55, -1, -61, -47, -1, 47, 54, 46, -14, -63,
+  -55, 8, 53, 56, 35, -16, -55, -35, 9, 46, 65, 25, -22, -64, -29, 13,
+  58, 64, 17, -23, -48, -29, 9, 38, 49, 13, -38, -60, -41, 14, 34, 67,
+  28, -14, -46, -51, -3, 44, 52, 45, -2, -61, -44, -22, 38, 44, 52, 3,
+  -45, -55, -25, 10, 47, 60, 28, -31, -52, -47, -14, 28, 44, 29, -6, -48,
+  -47, -37, 9, 57, 50, 12, -16, -60, -48, -18, 28, 50, 48, 3, -27, -41,
+  -44, -5, 45, 46, 29, -5, -43, -41, -35, 8, 34, 42, 32, -25, -43, -51,
+  -15, 11, 49, 45, 27, -27, -44, -36, -17, 18, 52, 50, 23, -20, -47, -47,
+  -9, 9, 36, 46, 27, -6, -39, -37, -24, 12, 44, 38, 28, -10, -45, -47,
+  -24, 9, 37, 48, 29, -2, -31, -45, -38, -1, 27, 36, 32, 14, -15, -36,
+  -42, -19, 12, 32, 47, 25, -8, -36, -40, -33, -1, 28, 36, 42, 19, -12,
+  -28, -46, -26, 2, 26, 43, 38, 7, -27, -42, -34, -19, 3, 29, 40, 25,
+  -1, -25, -44, -30, -18, 11, 33, 38, 32, -3, -24, -43, -40, -12, 9, 35,
+  38, 20, -2, -28, -35, -36, -20, 5, 28, 42, 34, 13, -13, -38, -38, -18,
+  -3, 26, 31, 37, 12, -11, -22, -41, -23, -11, 12, 27, 30, 22, 2, -22,
+  -39, -29, -15, 4, 19, 30, 31, 12, -9, -29, -31, -27, -16, 15, 28, 37,
+  29, 9, -12, -29, -38, -21, -9, 8, 24, 32, 27, 7, -15, -24, -37, -27,
+  -2, 13, 28, 28, 25, 9, -9, -31, -31, -21, -4, 7, 23, 36, 24, 9,
+  -7, -27, -35, -26, -11, 10, 18, 32, 24, 16, -1, -20, -30, -30, -15, 2,
+  15, 30, 29, 21, 7, -10, -25, -30, -21, -13, 7, 17, 33, 23, 19, -3,
+  -14, -31, -30, -25, -8, 10, 18, 29, 24, 17, -3, -21, -29, -24, -20, -6,
+  9, 21, 25, 25, 10, -5, -19, -28, -24, -22, -11, 12, 20, 30, 27, 15,
+  1, -17, -24, -28, -23, -8, 5, 20, 27, 28, 16, 7, -5, -17, -23, -25,
+  -19, -3, 11, 23, 24, 25, 16, 2, -11, -18, -28, -22, -12, 1, 15, 22,
+  24, 17, 8, -2, -15, -24, -27, -22, -12, 2, 12, 22, 25, 17, 11, 0,
+  -11, -18, -25, -22, -10, 1, 15, 21, 25, 17, 12, -1, -12, -22, -20, -21,
+  -12, -1, 10, 16, 24, 21, 18, 7, -3, -12, -22, -23, -20, -7, 3, 10,
+  20, 24, 21, 15, 1, -10, -19, -23, -22, -15, -9, 6, 14, 21, 20, 18,
+  13, -1, -11, -18, -22, -21, -17, -8, 3, 11, 18, 20, 19, 12, 5, -4,
+  -13, -19, -21, -16, -9, 0, 11, 17, 21, 17, 15, 6, -4, -13, -17, -21,
+  -19, -15, -7, 3, 13, 17, 20, 19, 12, 4, -6, -13, -16, -18, -18, -13,
+  -4, 4, 12, 18, 17, 15, 10, 3, -5, -13, -15, -19, -17, -13, -3, 4,
+  11, 14, 17, 16, 12, 5, -3, -10, -16, -18, -18, -14, -7, 1, 7, 13,
+  16, 16, 15, 10, 4, -4, -11, -16, -18, -16, -10, -7, 1, 9, 13, 15,
+  15, 13, 10, 2, -5, -12, -14, -17, -15, -11, -5, 1, 6, 11, 14, 15,
+  14, 9, 3, -2, -8, -14, -14, -16, -13, -9, -3, 4, 9, 13, 16, 14,
+  13, 8, 3, -5, -9, -12, -15, -14, -11, -7, -2, 5, 10, 12, 16, 15,
+  11, 6, 1, -4, -8, -13, -15, -15, -11, -9, -2, 4, 8, 12, 15, 15,
+  13, 9, 5, -2, -7, -10, -13, -14, -12, -11, -6, -1, 4, 10, 13, 14,
+  13, 12, 7, 3, -2, -7, -10, -12, -14, -12, -10, -5, -1, 4, 9, 10,
+  13, 14, 11, 7, 4, 0, -6, -8, -11, -12, -12, -10, -7, -3, 2, 6,
+  9, 11, 13, 12, 10, 6, 2, -2, -6, -8, -12, -12, -12, -9, -6, -3,
+  2, 6, 9, 11, 12, 11, 9, 7, 3, 0, -5, -8, -10, -12, -12, -10,
+  -7, -3, 0, 4, 8, 10, 11, 11, 11, 8, 5, 2, -1, -5, -8, -11,
+  -11, -10, -10, -6, -4, -1, 3, 7, 8, 10, 11, 10, 8, 6, 2, -1,
+  -4, -7, -9, -10, -10, -10, -7, -5, -2, 1, 5, 7, 9, 10, 10, 9,
+  7, 5, 1, -1, -4, -7, -8, -10, -10, -9, -7, -5, -2, 1, 4, 7,
+  8, 10, 9, 9, 8, 5, 3, 0, -3, -6, -7, -9, -10, -9, -8, -6,
+  -4, -1, 2, 4, 6, 8, 9, 9, 9, 7, 5, 3, 0, -2, -5, -7,
+  -9, -9, -9, -8, -7, -4, -2, 0, 3, 5, 7, 8, 9, 9, 8, 6,
+  4, 2, -1, -3, -5, -7, -8, -8, -9, -8, -6, -4, -2, 0, 2, 5,
+  6, 8, 8, 8, 8, 6, 5, 3, 0, -2, -4, -6, -7, -8, -8, -8,
+  -7, -5, -4, -1, 1, 3, 5, 6, 7, 8, 8, 7, 6, 5, 3, 1,
+  -1, -3, -5, -6, -7, -7, -7, -7, -6, -4, -3, -1, 1, 3, 5, 6,
+  7, 7, 7, 7, 6, 4, 3, 1, -1, -3, -4, -6, -7, -7, -7, -7,
+  -6, -5, -3, -2, 0, 2, 3, 5, 6, 7, 7, 7, 6, 5, 4, 3,
+  1, -1, -2, -4, -5, -6, -7, -7, -6, -6, -5, -4, -2, -1, 1, 2,
+  4, 5, 6, 6, 7, 6, 6, 5, 4, 2, 1, -1, -2, -4, -5, -6,
+};
+
+// fire_b - falling blaster sweep, higher, 150 ms
+static const int8_t PCM_FIRE_B[] PROGMEM = {
+  0, 0, -5, 6, 10, -16, -11, 16, 6, -29, -1, 43, -12, -28, 17, 29,
+  -37, -36, 46, 12, -52, 2, 50, 16, -77, -6, 87, -5, -64, 57, 91, -41,
+  -69, 71, 36, -70, -26, 125, 68, -110, -11, 105, 38, -127, -32, 94, -23, -127,
+  18, 126, -25, -81, 12, 73, -53, -90, 26, 69, -63, -72, 39, 74, -67, -93,
+  74, 102, -34, -95, 38, 73, -82, -85, 42, 84, -57, -121, 40, 75, -62, -74,
+  17, 110, -32, -109, 49, 102, 10, -118, 7, 87, 22, -125, -31, 123, 29, -97,
+  -48, 115, 76, -82, -62, 52, 68, -78, -78, 41, 109, -23, -78, 25, 83, 2,
+  -104, -25, 69, 59, -58, -34, 51, 49, -54, -66, 38, 98, -34, -116, 9, 88,
+  33, -81, -60, 59, 54, -54, -98, 0, 87, 16, -68, -22, 91, 48, -52, -93,
+  25, 77, -1, -65, -46, 65, 50, -50, -57, 22, 62, 16, -103, -32, 63, 40,
+  -43, -76, 17, 77, 29, -63, -63, 76, 54, -44, -83, 2, 82, 21, -43, -54,
+  39, 100, 23, -75, -41, 66, 76, -48, -71, -10, 79, 30, -71, -69, 9, 91,
+  41, -64, -40, 28, 70, -5, -79, -59, 49, 68, 3, -81, -36, 79, 70, -44,
+  -84, -23, 76, 45, -20, -65, 6, 81, 54, -39, -56, -13, 72, 45, -50, -67,
+  -10, 74, 31, -33, -64, 13, 71, 52, -34, -60, -2, 80, 62, -22, -85, -29,
+  69, 68, -32, -58, -42, 49, 52, 4, -79, -41, 51, 69, 17, -60, -62, 19,
+  71, 22, -34, -58, 4, 67, 37, -37, -71, -19, 67, 52, 0, -66, -40, 46,
+  69, 11, -62, -43, 2, 69, 52, -32, -67, -34, 52, 47, 6, -69, -57, 24,
+  55, 20, -44, -68, -3, 38, 46, -8, -58, -52, 18, 58, 37, -22, -56, -36,
+  30, 61, 11, -55, -42, 4, 54, 46, -2, -51, -32, 27, 59, 29, -28, -47,
+  -20, 27, 50, 21, -49, -60, -15, 52, 56, 10, -46, -39, -2, 54, 43, -5,
+  -42, -49, 24, 56, 29, -17, -49, -25, 25, 56, 40, -25, -44, -40, 22, 43,
+  40, -29, -45, -28, 19, 47, 37, -17, -48, -38, 8, 50, 40, -20, -43, -35,
+  -1, 38, 40, 3, -55, -34, 4, 44, 43, 5, -30, -56, -12, 27, 39, 9,
+  -29, -47, -28, 28, 57, 27, -21, -40, -26, 10, 36, 46, 0, -46, -35, -16,
+  30, 53, 20, -24, -46, -25, 18, 44, 39, -7, -35, -40, -4, 30, 40, 23,
+  -18, -36, -36, 19, 46, 36, 8, -30, -38, -9, 29, 51, 27, -15, -46, -34,
+  -8, 37, 37, 18, -19, -45, -21, 7, 32, 45, 4, -31, -48, -20, 23, 39,
+  32, 2, -28, -38, -13, 13, 45, 38, -9, -31, -45, -16, 17, 44, 27, 2,
+  -30, -31, -12, 20, 35, 26, -2, -27, -35, -21, 10, 39, 36, 6, -33, -37,
+  -21, 10, 31, 35, 10, -20, -43, -21, -1, 32, 35, 15, -18, -35, -38, -5,
+  28, 33, 27, -4, -34, -34, -17, 9, 32, 33, 11, -18, -38, -26, -1, 24,
+  30, 19, -4, -32, -37, -15, 4, 29, 31, 16, -9, -30, -29, -7, 17, 31,
+  30, 3, -27, -32, -25, -6, 22, 29, 26, 3, -20, -33, -22, 3, 21, 30,
+  22, -6, -28, -29, -21, 4, 26, 29, 21, -3, -27, -32, -20, 12, 25, 32,
+  18, -11, -26, -33, -18, 9, 27, 33, 21, -5, -22, -30, -17, 4, 21, 28,
+  25, 0, -21, -32, -20, -2, 13, 26, 24, 9, -9, -28, -28, -12, 7, 26,
+  28, 20, -5, -24, -25, -24, 2, 19, 29, 21, 9, -11, -24, -25, -14, 8,
+  21, 28, 19, -3, -16, -28, -19, -5, 17, 29, 26, 10, -10, -20, -28, -17,
+  0, 15, 28, 20, 11, -13, -24, -23, -15, 0, 15, 25, 25, 9, -13, -23,
+  -23, -14, 1, 19, 24, 19, 9, -9, -20, -22, -14, -1, 14, 27, 21, 13,
+  -7, -18, -25, -17, -3, 13, 19, 24, 17, -1, -16, -26, -24, -13, 4, 16,
+  23, 19, 5, -10, -20, -23, -17, -2, 11, 23, 25, 14, -4, -12, -24, -22,
+  -12, 6, 19, 20, 20, 5, -5, -20, -20, -18, -8, 7, 16, 21, 18, 3,
+  -6, -18, -23, -17, -4, 7, 18, 21, 18, 3, -10, -18, -23, -17, -6, 10,
+  17, 21, 17, 4, -9, -19, -21, -15, -5, 6, 15, 18, 16, 10, -3, -15,
+  -20, -19, -9, 3, 14, 19, 18, 11, 1, -11, -18, -18, -14, -4, 8, 18,
+  21, 16, 5, -4, -15, -21, -18, -10, 2, 11, 18, 20, 13, 5, -8, -14,
+  -18, -15, -8, 4, 10, 19, 18, 11, 4, -8, -16, -18, -14, -7, 3, 11,
+  17, 15, 10, 2, -6, -15, -18, -17, -7, 0, 10, 18, 16, 14, 6, -6,
+  -12, -18, -15, -10, -1, 9, 14, 16, 15, 8, -1, -8, -16, -18, -13, -6,
+  3, 10, 15, 17, 13, 3, -4, -11, -14, -16, -11, -3, 6, 12, 15, 15,
+  10, 2, -7, -11, -15, -15, -10, -3, 7, 12, 14, 15, 10, 1, -6, -13,
+  -15, -14, -10, -4, 5, 10, 15, 15, 11, 4, -5, -10, -15, -13, -10, -6,
+  3, 10, 13, 13, 12, 7, 0, -8, -12, -15, -13, -9, 0, 6, 10, 14,
+  13, 9, 3, -4, -10, -12, -13, -11, -6, 0, 7, 12, 14, 13, 9, 3,
+  -4, -9, -13, -14, -11, -5, 1, 6, 11, 14, 13, 9, 2, -3, -8, -11,
+  -13, -12, -6, -2, 6, 9, 12, 13, 9, 4, -1, -6, -10, -13, -12, -8,
+  -3, 3, 8, 11, 13, 11, 7, 3, -3, -9, -11, -13, -10, -7, -2, 3,
+  9, 11, 12, 10, 7, 1, -4, -8, -11, -12, -11, -7, -2, 4, 8, 11,
+  11, 10, 7, 2, -3, -7, -10, -12, -11, -7, -4, 2, 6, 10, 11, 11,
+  9, 4, -1, -5, -9, -10, -11, -8, -5, -1, 3, 7, 10, 10, 10, 7,
+  3, -1, -5, -9, -10, -10, -8, -5, 0, 3, 7, 10, 10, 9, 7, 3,
+  -1, -5, -8, -9, -10, -8, -6, -1, 2, 6, 8, 10, 9, 8, 4, 1,
+  -4, -7, -9, -9, -9, -7, -4, 0, 4, 7, 9, 9, 9, 6, 3, 0,
+  -4, -7, -9, -9, -8, -6, -3, 1, 4, 7, 8, 9, 8, 6, 3, 0,
+  -3, -6, -8, -9, -8, -7, -4, -1, 3, 6, 8, 9, 8, 7, 5, 2,
+  -2, -5, -7, -8, -8, -7, -5, -3, 0, 3, 6, 8, 9, 8, 6, 4,
+  1, -2, -5, -7, -8, -8, -7, -5, -3, 0, 3, 6, 7, 8, 8, 7,
+  4, 2, -1, -4, -6, -7, -8, -7, -6, -4, -1, 2, 4, 6, 7, 8,
+  7, 6, 3, 1, -2, -4, -6, -7, -8, -7, -6, -4, -1, 1, 4, 6,
+  7, 8, 7, 6, 4, 2, -1, -3, -5, -7, -7, -7, -6, -4, -2, 0,
+  3, 5, 6, 7, 7, 6, 5, 3, 1, -2, -4, -5, -7, -7, -7, -5,
+  -4, -2, 1, 3, 5, 6, 7, 7, 6, 5, 3, 1, -1, -3, -5, -6,
+  -7, -6, -6, -4, -2, 0, 2, 4, 5, 6, 6, 6, 5, 4, 2, 0,
+};
+
+// stun_a - warbling stun buzz, 200 ms
+static const int8_t PCM_STUN_A[] PROGMEM = {
+  0, 2, 4, 6, 8, 9, -11, -13, -15, -17, -19, -21, 23, 25, 26, 28,
+  30, 32, 34, -36, -38, -39, -41, -43, -45, 47, 49, 51, 52, 54, 56, -58,
+  -60, -62, -63, -65, -67, 69, 71, 72, 74, 74, 74, -74, -74, -74, -74, -74,
+  74, 74, 74, 74, 74, 74, -74, -74, -74, -73, -73, -73, 73, 73, 73, 73,
+  73, 73, -73, -73, -73, -73, -73, -73, 73, 73, 73, 73, 73, 73, -72, -72,
+  -72, -72, -72, -72, 72, 72, 72, 72, 72, 72, -72, -72, -72, -72, -72, -72,
+  -72, 72, 72, 71, 71, 71, 71, -71, -71, -71, -71, -71, -71, -71, 71, 71,
+  71, 71, 71, 71, 71, -71, -71, -71, -70, -70, -70, -70, -70, 70, 70, 70,
+  70, 70, 70, 70, -70, -70, -70, -70, -70, -70, -70, -70, 70, 69, 69, 69,
+  69, 69, 69, 69, -69, -69, -69, -69, -69, -69, -69, -69, 69, 69, 69, 69,
+  69, 69, 68, -68, -68, -68, -68, -68, -68, -68, -68, 68, 68, 68, 68, 68,
+  68, 68, -68, -68, -68, -68, -68, -67, -67, -67, 67, 67, 67, 67, 67, 67,
+  67, -67, -67, -67, -67, -67, -67, 67, 67, 67, 67, 67, 66, 66, -66, -66,
+  -66, -66, -66, -66, 66, 66, 66, 66, 66, 66, 66, -66, -66, -66, -66, -66,
+  -66, 65, 65, 65, 65, 65, 65, -65, -65, -65, -65, -65, -65, 65, 65, 65,
+  65, 65, 65, -65, -65, -65, -64, -64, 64, 64, 64, 64, 64, 64, -64, -64,
+  -64, -64, -64, -64, 64, 64, 64, 64, 64, 64, -64, -63, -63, -63, -63, -63,
+  63, 63, 63, 63, 63, 63, -63, -63, -63, -63, -63, -63, 63, 63, 63, 63,
+  62, 62, -62, -62, -62, -62, -62, -62, -62, 62, 62, 62, 62, 62, 62, -62,
+  -62, -62, -62, -62, -62, -61, 61, 61, 61, 61, 61, 61, 61, -61, -61, -61,
+  -61, -61, -61, -61, -61, 61, 61, 61, 61, 61, 60, 60, -60, -60, -60, -60,
+  -60, -60, -60, -60, 60, 60, 60, 60, 60, 60, 60, 60, -60, -60, -60, -59,
+  -59, -59, -59, -59, 59, 59, 59, 59, 59, 59, 59, -59, -59, -59, -59, -59,
+  -59, -59, -59, 59, 58, 58, 58, 58, 58, 58, -58, -58, -58, -58, -58, -58,
+  -58, -58, 58, 58, 58, 58, 58, 58, 58, -57, -57, -57, -57, -57, -57, -57,
+  57, 57, 57, 57, 57, 57, -57, -57, -57, -57, -57, -57, 57, 57, 56, 56,
+  56, 56, 56, -56, -56, -56, -56, -56, -56, 56, 56, 56, 56, 56, 56, -56,
+  -56, -56, -56, -55, -55, 55, 55, 55, 55, 55, 55, -55, -55, -55, -55, -55,
+  55, 55, 55, 55, 55, 55, -55, -55, -54, -54, -54, -54, 54, 54, 54, 54,
+  54, 54, -54, -54, -54, -54, -54, -54, 54, 54, 54, 54, 54, 53, -53, -53,
+  -53, -53, -53, -53, 53, 53, 53, 53, 53, 53, -53, -53, -53, -53, -53, -53,
+  -53, 53, 52, 52, 52, 52, 52, -52, -52, -52, -52, -52, -52, -52, 52, 52,
+  52, 52, 52, 52, 52, -52, -52, -51, -51, -51, -51, -51, -51, 51, 51, 51,
+  51, 51, 51, 51, -51, -51, -51, -51, -51, -51, -51, -51, 50, 50, 50, 50,
+  50, 50, 50, 50, -50, -50, -50, -50, -50, -50, -50, -50, 50, 50, 50, 50,
+  50, 49, 49, -49, -49, -49, -49, -49, -49, -49, -49, 49, 49, 49, 49, 49,
+  49, 49, -49, -49, -49, -49, -48, -48, -48, -48, 48, 48, 48, 48, 48, 48,
+  48, -48, -48, -48, -48, -48, -48, -48, 48, 48, 48, 47, 47, 47, -47, -47,
+  -47, -47, -47, -47, 47, 47, 47, 47, 47, 47, 47, -47, -47, -47, -47, -47,
+  -46, 46, 46, 46, 46, 46, 46, -46, -46, -46, -46, -46, -46, 46, 46, 46,
+  46, 46, 46, -46, -46, -45, -45, -45, 45, 45, 45, 45, 45, 45, -45, -45,
+  -45, -45, -45, -45, 45, 45, 45, 45, 45, 45, -44, -44, -44, -44, -44, -44,
+  44, 44, 44, 44, 44, 44, -44, -44, -44, -44, -44, -44, 44, 44, 44, 43,
+  43, 43, -43, -43, -43, -43, -43, -43, -43, 43, 43, 43, 43, 43, 43, -43,
+  -43, -43, -43, -43, -42, -42, 42, 42, 42, 42, 42, 42, 42, -42, -42, -42,
+  -42, -42, -42, -42, -42, 42, 42, 42, 42, 41, 41, 41, -41, -41, -41, -41,
+  -41, -41, -41, -41, 41, 41, 41, 41, 41, 41, 41, 41, -41, -41, -40, -40,
+  -40, -40, -40, -40, 40, 40, 40, 40, 40, 40, 40, -40, -40, -40, -40, -40,
+  -40, -40, -40, 39, 39, 39, 39, 39, 39, 39, -39, -39, -39, -39, -39, -39,
+  -39, -39, 39, 39, 39, 39, 39, 39, 38, -38, -38, -38, -38, -38, -38, 38,
+  38, 38, 38, 38, 38, 38, -38, -38, -38, -38, -38, -38, 38, 37, 37, 37,
+  37, 37, 37, -37, -37, -37, -37, -37, -37, 37, 37, 37, 37, 37, 37, -37,
+  -37, -37, -36, -36, -36, 36, 36, 36, 36, 36, 36, -36, -36, -36, -36, -36,
+  36, 36, 36, 36, 36, 36, -36, -35, -35, -35, -35, -35, 35, 35, 35, 35,
+  35, 35, -35, -35, -35, -35, -35, -35, 35, 35, 35, 35, 34, 34, -34, -34,
+  -34, -34, -34, -34, 34, 34, 34, 34, 34, 34, -34, -34, -34, -34, -34, -34,
+  -34, 33, 33, 33, 33, 33, 33, -33, -33, -33, -33, -33, -33, -33, 33, 33,
+  33, 33, 33, 33, 33, -33, -32, -32, -32, -32, -32, -32, -32, 32, 32, 32,
+  32, 32, 32, 32, -32, -32, -32, -32, -32, -32, -32, -31, 31, 31, 31, 31,
+  31, 31, 31, 31, -31, -31, -31, -31, -31, -31, -31, -31, 31, 31, 31, 31,
+  30, 30, 30, -30, -30, -30, -30, -30, -30, -30, -30, 30, 30, 30, 30, 30,
+  30, 30, -30, -30, -30, -29, -29, -29, -29, -29, 29, 29, 29, 29, 29, 29,
+  29, -29, -29, -29, -29, -29, -29, 29, 29, 29, 28, 28, 28, 28, -28, -28,
+  -28, -28, -28, -28, 28, 28, 28, 28, 28, 28, 28, -28, -28, -28, -28, -27,
+  -27, 27, 27, 27, 27, 27, 27, -27, -27, -27, -27, -27, -27, 27, 27, 27,
+  27, 27, 27, -27, -26, -26, -26, -26, 26, 26, 26, 26, 26, 26, -26, -26,
+  -26, -26, -26, -26, 26, 26, 26, 26, 26, 25, -25, -25, -25, -25, -25, -25,
+  25, 25, 25, 25, 25, 25, -25, -25, -25, -25, -25, -25, 25, 25, 24, 24,
+  24, 24, -24, -24, -24, -24, -24, -24, -24, 24, 24, 24, 24, 24, 24, -24,
+  -24, -24, -24, -23, -23, -23, 23, 23, 23, 23, 23, 23, 23, -23, -23, -23,
+  -23, -23, -23, -23, -23, 23, 23, 23, 22, 22, 22, 22, -22, -22, -22, -22,
+  -22, -22, -22, -22, 22, 22, 22, 22, 22, 22, 22, 22, -22, -21, -21, -21,
+  -21, -21, -21, -21, 21, 21, 21, 21, 21, 21, 21, -21, -21, -21, -21, -21,
+  -21, -21, -20, 20, 20, 20, 20, 20, 20, 20, -20, -20, -20, -20, -20, -20,
+  -20, -20, 20, 20, 20, 20, 20, 19, 19, -19, -19, -19, -19, -19, -19, 19,
+  19, 19, 19, 19, 19, 19, -19, -19, -19, -19, -19, -19, 18, 18, 18, 18,
+  18, 18, 18, -18, -18, -18, -18, -18, -18, 18, 18, 18, 18, 18, 18, -18,
+  -18, -17, -17, -17, -17, 17, 17, 17, 17, 17, 17, -17, -17, -17, -17, -17,
+  17, 17, 17, 17, 17, 17, -16, -16, -16, -16, -16, -16, 16, 16, 16, 16,
+  16, 16, -16, -16, -16, -16, -16, -16, 16, 16, 16, 15, 15, 15, -15, -15,
+  -15, -15, -15, -15, 15, 15, 15, 15, 15, 15, -15, -15, -15, -15, -15, -15,
+  -14, 14, 14, 14, 14, 14, 14, -14, -14, -14, -14, -14, -14, -14, 14, 14,
+  14, 14, 14, 14, 14, -13, -13, -13, -13, -13, -13, -13, -13, 13, 13, 13,
+  13, 13, 13, 13, -13, -13, -13, -13, -13, -13, -12, -12, 12, 12, 12, 12,
+  12, 12, 12, 12, -12, -12, -12, -12, -12, -12, -12, -12, 12, 12, 12, 11,
+  11, 11, 11, -11, -11, -11, -11, -11, -11, -11, -11, 11, 11, 11, 11, 11,
+  11, 11, -11, -11, -10, -10, -10, -10, -10, -10, 10, 10, 10, 10, 10, 10,
+  10, -10, -10, -10, -10, -10, -10, 10, 10, 9, 9, 9, 9, 9, -9, -9,
+  -9, -9, -9, -9, 9, 9, 9, 9, 9, 9, 9, -9, -9, -9, -8, -8,
+  -8, 8, 8, 8, 8, 8, 8, -8, -8, -8, -8, -8, -8, 8, 8, 8,
+  8, 8, 8, -7, -7, -7, -7, -7, 7, 7, 7, 7, 7, 7, -7, -7,
+  -7, -7, -7, -7, 7, 7, 7, 7, 6, 6, -6, -6, -6, -6, -6, -6,
+  6, 6, 6, 6, 6, 6, -6, -6, -6, -6, -6, -6, 6, 5, 5, 5,
+  5, 5, -5, -5, -5, -5, -5, -5, -5, 5, 5, 5, 5, 5, 5, -5,
+  -5, -5, -4, -4, -4, -4, 4, 4, 4, 4, 4, 4, 4, -4, -4, -4,
+  -4, -4, -4, -4, -4, 4, 4, 3, 3, 3, 3, 3, -3, -3, -3, -3,
+  -3, -3, -3, -3, 3, 3, 3, 3, 3, 3, 3, 3, -2, -2, -2, -2,
+  -2, -2, -2, -2, 2, 2, 2, 2, 2, 2, 2, -2, -2, -2, -2, -2,
+  -2, -1, -1, 1, 1, 1, 1, 1, 1, 1, -1, -1, -1, -1, -1, -1,
+  -1, -1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// stun_b - warbling stun buzz, lower, 200 ms
+static const int8_t PCM_STUN_B[] PROGMEM = {
+  0, 2, 4, 6, 8, 9, 11, 13, -15, -17, -19, -21, -23, -25, -26, -28,
+  -30, 32, 34, 36, 38, 39, 41, 43, 45, -47, -49, -51, -52, -54, -56, -58,
+  -60, 62, 63, 65, 67, 69, 71, 72, 74, -74, -74, -74, -74, -74, -74, -74,
+  -74, 74, 74, 74, 74, 74, 74, 74, 74, -73, -73, -73, -73, -73, -73, -73,
+  -73, 73, 73, 73, 73, 73, 73, 73, -73, -73, -73, -73, -73, -73, -72, -72,
+  72, 72, 72, 72, 72, 72, 72, 72, -72, -72, -72, -72, -72, -72, -72, -72,
+  72, 72, 72, 71, 71, 71, 71, 71, -71, -71, -71, -71, -71, -71, -71, -71,
+  71, 71, 71, 71, 71, 71, 71, 71, -70, -70, -70, -70, -70, -70, -70, -70,
+  -70, 70, 70, 70, 70, 70, 70, 70, 70, 70, -70, -70, -70, -69, -69, -69,
+  -69, -69, -69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, -69, -69, -69,
+  -69, -69, -68, -68, -68, -68, 68, 68, 68, 68, 68, 68, 68, 68, 68, 68,
+  -68, -68, -68, -68, -68, -68, -68, -67, -67, -67, -67, 67, 67, 67, 67, 67,
+  67, 67, 67, 67, 67, -67, -67, -67, -67, -67, -67, -67, -66, -66, -66, -66,
+  66, 66, 66, 66, 66, 66, 66, 66, 66, 66, -66, -66, -66, -66, -66, -66,
+  -66, -65, -65, -65, 65, 65, 65, 65, 65, 65, 65, 65, 65, 65, -65, -65,
+  -65, -65, -65, -65, -65, -65, -64, -64, 64, 64, 64, 64, 64, 64, 64, 64,
+  64, -64, -64, -64, -64, -64, -64, -64, -64, -64, 64, 63, 63, 63, 63, 63,
+  63, 63, 63, -63, -63, -63, -63, -63, -63, -63, -63, 63, 63, 63, 63, 63,
+  62, 62, 62, 62, -62, -62, -62, -62, -62, -62, -62, -62, 62, 62, 62, 62,
+  62, 62, 62, 62, -62, -61, -61, -61, -61, -61, -61, -61, 61, 61, 61, 61,
+  61, 61, 61, -61, -61, -61, -61, -61, -61, -61, -60, 60, 60, 60, 60, 60,
+  60, 60, 60, -60, -60, -60, -60, -60, -60, -60, -60, 60, 60, 60, 60, 59,
+  59, 59, 59, -59, -59, -59, -59, -59, -59, -59, 59, 59, 59, 59, 59, 59,
+  59, 59, -59, -59, -58, -58, -58, -58, -58, -58, -58, 58, 58, 58, 58, 58,
+  58, 58, 58, -58, -58, -58, -58, -58, -58, -57, -57, -57, 57, 57, 57, 57,
+  57, 57, 57, 57, 57, -57, -57, -57, -57, -57, -57, -57, -57, -57, 56, 56,
+  56, 56, 56, 56, 56, 56, 56, -56, -56, -56, -56, -56, -56, -56, -56, -56,
+  -56, 56, 56, 55, 55, 55, 55, 55, 55, 55, 55, -55, -55, -55, -55, -55,
+  -55, -55, -55, -55, -55, 55, 55, 55, 54, 54, 54, 54, 54, 54, 54, 54,
+  -54, -54, -54, -54, -54, -54, -54, -54, -54, -54, 54, 54, 54, 53, 53, 53,
+  53, 53, 53, 53, 53, -53, -53, -53, -53, -53, -53, -53, -53, -53, -53, 53,
+  53, 53, 52, 52, 52, 52, 52, 52, 52, -52, -52, -52, -52, -52, -52, -52,
+  -52, -52, 52, 52, 52, 52, 52, 51, 51, 51, 51, 51, -51, -51, -51, -51,
+  -51, -51, -51, -51, -51, 51, 51, 51, 51, 51, 51, 51, 50, 50, -50, -50,
+  -50, -50, -50, -50, -50, -50, 50, 50, 50, 50, 50, 50, 50, 50, -50, -50,
+  -50, -49, -49, -49, -49, -49, -49, 49, 49, 49, 49, 49, 49, 49, 49, -49,
+  -49, -49, -49, -49, -49, -49, 48, 48, 48, 48, 48, 48, 48, 48, -48, -48,
+  -48, -48, -48, -48, -48, -48, 48, 48, 48, 48, 48, 47, 47, 47, -47, -47,
+  -47, -47, -47, -47, -47, 47, 47, 47, 47, 47, 47, 47, 47, -47, -47, -47,
+  -46, -46, -46, -46, -46, 46, 46, 46, 46, 46, 46, 46, 46, -46, -46, -46,
+  -46, -46, -46, -46, -46, 45, 45, 45, 45, 45, 45, 45, 45, 45, -45, -45,
+  -45, -45, -45, -45, -45, -45, 45, 45, 45, 45, 44, 44, 44, 44, 44, -44,
+  -44, -44, -44, -44, -44, -44, -44, -44, 44, 44, 44, 44, 44, 44, 44, 43,
+  43, 43, -43, -43, -43, -43, -43, -43, -43, -43, -43, -43, 43, 43, 43, 43,
+  43, 43, 43, 43, 42, 42, -42, -42, -42, -42, -42, -42, -42, -42, -42, -42,
+  42, 42, 42, 42, 42, 42, 42, 42, 42, 41, -41, -41, -41, -41, -41, -41,
+  -41, -41, -41, -41, -41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 40, -40,
+  -40, -40, -40, -40, -40, -40, -40, -40, -40, -40, 40, 40, 40, 40, 40, 40,
+  40, 40, 40, -39, -39, -39, -39, -39, -39, -39, -39, -39, -39, 39, 39, 39,
+  39, 39, 39, 39, 39, 39, -39, -39, -38, -38, -38, -38, -38, -38, -38, -38,
+  38, 38, 38, 38, 38, 38, 38, 38, -38, -38, -38, -38, -38, -37, -37, -37,
+  -37, 37, 37, 37, 37, 37, 37, 37, 37, -37, -37, -37, -37, -37, -37, -37,
+  -37, 37, 36, 36, 36, 36, 36, 36, 36, -36, -36, -36, -36, -36, -36, -36,
+  -36, 36, 36, 36, 36, 36, 36, 35, 35, -35, -35, -35, -35, -35, -35, -35,
+  -35, 35, 35, 35, 35, 35, 35, 35, -35, -35, -35, -35, -34, -34, -34, -34,
+  34, 34, 34, 34, 34, 34, 34, 34, -34, -34, -34, -34, -34, -34, -34, -34,
+  34, 33, 33, 33, 33, 33, 33, 33, -33, -33, -33, -33, -33, -33, -33, -33,
+  33, 33, 33, 33, 33, 33, 32, 32, -32, -32, -32, -32, -32, -32, -32, -32,
+  -32, 32, 32, 32, 32, 32, 32, 32, 32, 32, -32, -31, -31, -31, -31, -31,
+  -31, -31, -31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, -31, -31, -31,
+  -30, -30, -30, -30, -30, -30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+  -30, -30, -30, -30, -30, -29, -29, -29, -29, -29, -29, 29, 29, 29, 29, 29,
+  29, 29, 29, 29, 29, -29, -29, -29, -29, -29, -28, -28, -28, -28, -28, -28,
+  28, 28, 28, 28, 28, 28, 28, 28, 28, 28, -28, -28, -28, -28, -28, -27,
+  -27, -27, -27, -27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, -27, -27,
+  -27, -27, -27, -27, -26, -26, -26, -26, 26, 26, 26, 26, 26, 26, 26, 26,
+  26, -26, -26, -26, -26, -26, -26, -26, -26, -25, 25, 25, 25, 25, 25, 25,
+  25, 25, 25, -25, -25, -25, -25, -25, -25, -25, -25, 25, 25, 25, 24, 24,
+  24, 24, 24, 24, -24, -24, -24, -24, -24, -24, -24, -24, 24, 24, 24, 24,
+  24, 24, 24, 23, -23, -23, -23, -23, -23, -23, -23, -23, 23, 23, 23, 23,
+  23, 23, 23, -23, -23, -23, -23, -23, -22, -22, -22, 22, 22, 22, 22, 22,
+  22, 22, 22, -22, -22, -22, -22, -22, -22, -22, -22, 22, 22, 21, 21, 21,
+  21, 21, 21, -21, -21, -21, -21, -21, -21, -21, 21, 21, 21, 21, 21, 21,
+  21, 21, -20, -20, -20, -20, -20, -20, -20, -20, -20, 20, 20, 20, 20, 20,
+  20, 20, 20, -20, -20, -20, -20, -19, -19, -19, -19, -19, 19, 19, 19, 19,
+  19, 19, 19, 19, 19, -19, -19, -19, -19, -19, -19, -19, -18, -18, 18, 18,
+  18, 18, 18, 18, 18, 18, 18, -18, -18, -18, -18, -18, -18, -18, -18, -18,
+  -18, 17, 17, 17, 17, 17, 17, 17, 17, 17, 17, -17, -17, -17, -17, -17,
+  -17, -17, -17, -17, -17, 17, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+  -16, -16, -16, -16, -16, -16, -16, -16, -16, -16, 16, 15, 15, 15, 15, 15,
+  15, 15, 15, 15, 15, -15, -15, -15, -15, -15, -15, -15, -15, -15, -15, 15,
+  14, 14, 14, 14, 14, 14, 14, 14, 14, -14, -14, -14, -14, -14, -14, -14,
+  -14, -14, 14, 14, 14, 13, 13, 13, 13, 13, 13, 13, -13, -13, -13, -13,
+  -13, -13, -13, -13, -13, 13, 13, 13, 13, 13, 12, 12, 12, 12, -12, -12,
+  -12, -12, -12, -12, -12, -12, 12, 12, 12, 12, 12, 12, 12, 12, -12, -11,
+  -11, -11, -11, -11, -11, -11, -11, 11, 11, 11, 11, 11, 11, 11, 11, -11,
+  -11, -11, -11, -11, -10, -10, 10, 10, 10, 10, 10, 10, 10, 10, -10, -10,
+  -10, -10, -10, -10, -10, -10, 10, 10, 10, 9, 9, 9, 9, 9, -9, -9,
+  -9, -9, -9, -9, -9, 9, 9, 9, 9, 9, 9, 9, 9, -9, -8, -8,
+  -8, -8, -8, -8, -8, 8, 8, 8, 8, 8, 8, 8, 8, -8, -8, -8,
+  -8, -8, -8, -7, -7, 7, 7, 7, 7, 7, 7, 7, 7, 7, -7, -7,
+  -7, -7, -7, -7, -7, -7, 7, 7, 6, 6, 6, 6, 6, 6, 6, -6,
+  -6, -6, -6, -6, -6, -6, -6, -6, 6, 6, 6, 6, 6, 5, 5, 5,
+  5, 5, -5, -5, -5, -5, -5, -5, -5, -5, -5, -5, 5, 5, 5, 5,
+  5, 5, 4, 4, 4, 4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4,
+  4, 4, 4, 4, 4, 4, 4, 3, 3, 3, -3, -3, -3, -3, -3, -3,
+  -3, -3, -3, -3, -3, 3, 3, 3, 3, 3, 3, 3, 2, 2, 2, -2,
+  -2, -2, -2, -2, -2, -2, -2, -2, -2, -2, 2, 2, 2, 2, 2, 2,
+  2, 1, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// reload - noise burst and clunk, 250 ms
+static const int8_t PCM_RELOAD[] PROGMEM = {
+  109, -38, 24, 23, 101, 6, -102, -16, -40, 6, 10, 117, 5, -52, 4, -43,
+  -85, -96, 38, -83, -66, -47, -18, 96, -55, 30, 29, 85, 33, 99, -13, -102,
+  14, -114, 100, -46, 0, 32, -87, -31, -30, 101, -77, 70, 37, 50, 67, -2,
+  100, 10, -32, -95, -82, -1, 40, -86, -92, 49, -90, -102, 20, 99, 24, 95,
+  -55, 45, 11, -19, 17, 39, -69, 35, 69, -88, -93, 84, 32, -9, -91, 40,
+  58, -23, 28, 51, -89, 5, -60, 22, -41, -72, 14, -59, 17, -4, 48, -45,
+  69, 10, 58, 32, -67, -49, -30, -11, -27, 48, 38, -87, 75, 41, 12, 60,
+  -85, 8, 44, 68, -35, 78, 21, 83, 9, 68, 13, 1, 61, 32, 9, 0,
+  -5, -26, -15, 29, -66, 52, 50, -48, 33, 17, 14, -70, 79, -44, 59, 77,
+  46, -19, -70, -70, 41, 58, 59, 38, -34, 57, 12, 30, -60, 53, -23, -5,
+  34, -12, 30, 58, 64, -69, 36, 70, 53, 24, -46, -60, 14, 35, 16, -67,
+  -44, 50, -62, -14, -32, -11, 58, 54, -7, -59, -40, -64, -12, 46, -8, -43,
+  -41, -54, 26, -18, 56, 24, 4, 8, -64, -29, -18, -61, 63, -10, -17, 22,
+  41, -5, 27, 31, -49, 29, 33, 47, -36, -19, -8, 25, 34, -54, -49, -23,
+  54, 37, -17, -50, -23, -7, -40, 9, 4, -35, 54, -20, 11, 10, -10, 57,
+  18, -14, 8, -14, -25, -16, 37, -40, 4, -22, 40, -45, -1, -16, -11, 35,
+  17, -45, 51, 45, -47, -37, 8, 49, -33, -45, -11, -32, -11, -15, 9, -34,
+  -10, 44, -27, 24, -13, 11, -49, 30, 20, -21, 26, -23, 41, -29, 26, -45,
+  26, -37, 17, -43, 14, 0, -1, 11, -26, 17, -8, -42, 45, 41, -42, 0,
+  14, -28, 12, -31, -26, -44, 12, 44, -9, -12, -15, -31, -16, 17, 12, -15,
+  -4, 32, -29, 36, 19, -1, 37, 31, -27, 10, -7, 28, -33, 1, -38, 21,
+  -23, 4, 16, 26, -7, -13, 33, 33, -8, 32, 33, -18, 28, -39, -4, -35,
+  5, 23, 15, 4, -36, -26, 35, 12, -3, -37, 4, 26, -21, 2, 1, 11,
+  7, 24, 35, 15, 16, -1, -12, 16, -21, -18, 11, 28, -24, -14, -30, -21,
+  31, -30, 18, 19, -17, -10, -25, 6, -18, -29, 2, -22, -30, 3, -31, 33,
+  4, 6, -2, -6, 6, -26, 14, 23, 0, 16, 16, 10, -16, 15, -14, 19,
+  -13, 1, 0, 7, -24, -27, 25, -12, 30, 9, -8, 5, 13, 30, 22, 24,
+  30, 15, 0, -16, 22, -15, -5, 9, -19, -23, 13, -4, 13, 15, 28, -9,
+  -22, -11, 26, -19, 13, -3, 17, 20, 0, 4, -10, -22, -22, -14, -14, 25,
+  -25, 18, -24, 26, 10, -10, 6, 12, 17, -19, 22, 13, 22, -22, 23, 14,
+  -17, 14, 11, -3, 9, -12, -17, -5, 18, -16, -13, -2, 6, 21, 5, -11,
+  -9, 9, 21, 21, 4, -10, 17, -14, 19, -10, -17, -22, -3, -7, 10, 17,
+  -3, 20, 23, -6, -15, -20, -11, -7, 22, -9, -15, 20, 4, 6, 14, -2,
+  12, 5, -18, -21, 12, -21, 12, -6, 18, -19, -19, 17, -13, 11, -13, 3,
+  -12, 1, 9, 3, 15, -8, 2, 5, 17, 6, -19, -1, -19, -7, 16, -6,
+  -3, 17, 8, -15, 19, 6, 15, 12, 19, -13, -16, -18, 0, -19, 10, -14,
+  11, -7, -1, -16, -13, -18, 4, -17, -14, -4, 17, 1, 3, -7, -18, -17,
+  1, 17, 5, -8, -5, 16, -10, 14, -2, 8, 0, -15, -13, 10, 4, 5,
+  15, 12, -3, 15, 0, 3, -11, 7, -8, -14, 1, -14, 14, 15, 8, -11,
+  0, -4, 12, 8, -6, 11, -10, -6, -15, -8, 7, -13, -6, 9, -12, 13,
+  -8, 8, -4, -1, -5, 1, -2, -2, 1, -11, 3, -7, -1, -3, -12, -5,
+  4, -14, -9, 12, -2, -13, 6, 5, 3, -13, 14, -13, 4, -1, 9, 1,
+  -1, 6, -11, 6, 11, -2, 0, -2, -3, 3, 2, 6, 4, -10, 7, 1,
+  -9, 11, -7, 6, -4, 6, 3, -10, 2, 4, 0, 11, -11, 4, -10, 0,
+  -8, 9, -4, -4, -8, 2, -7, 3, 1, -9, -8, -9, -11, 4, 0, 3,
+  2, 7, 4, 10, 4, 5, 1, -9, 1, -6, -2, 2, -7, -4, 7, 8,
+  6, -7, -3, 8, 8, 3, 9, 9, 6, 9, -2, 8, -7, 2, 3, 0,
+  -5, 3, 0, 1, 5, 0, 0, 5, 7, 5, 7, 4, 10, -5, -7, -7,
+  4, -8, -9, 8, 1, -9, 0, -1, -9, 0, -4, 4, 0, 6, -4, 2,
+  7, 8, -5, 9, -8, 9, 4, -4, 5, -7, 5, -7, -3, -6, 4, 8,
+  -7, 9, -5, -5, 2, -8, -3, 6, -2, -2, 2, 4, 4, -1, 3, -3,
+  5, -8, 0, -6, -8, 5, -4, 4, 8, 3, 4, 8, 2, 7, -2, 6,
+  0, 8, -5, -4, -3, 4, 3, 5, -4, -2, -3, 5, -5, 3, -1, -5,
+  -2, -3, -4, 0, 3, 7, 7, -2, 5, 6, -2, -1, 3, 3, 2, 0,
+  3, -6, -1, -6, 6, 6, -5, -4, -5, -3, -1, 6, -4, 1, -7, 2,
+  3, -3, 1, -6, 5, -1, 1, 6, -6, -4, 0, 6, -4, -2, 0, 0,
+  3, -3, -4, -1, 5, 5, 4, -3, -1, -1, 3, -1, -6, -4, -2, -5,
+  -6, 0, -4, 2, -2, 2, 0, -3, 4, 5, 0, 1, -3, 5, -4, -6,
+  3, 3, 1, -3, -4, -4, -4, -1, 1, -6, 1, 4, 3, 5, 3, -3,
+  -5, 3, 0, 4, -4, 5, 5, -5, -1, 4, 1, 1, -3, -4, 1, 3,
+  2, -3, 0, -5, 3, 4, 3, 0, -3, 0, -1, 1, 2, 5, -1, 0,
+  0, -4, -2, 2, -2, -4, -1, -3, -2, -1, 4, -2, 2, -3, 0, 1,
+  0, -1, 2, -4, 1, -2, -4, -1, -1, -4, -2, -2, -3, 2, -1, 0,
+  2, 2, 2, -1, 0, 1, -1, -3, -4, -3, -4, 4, -4, 0, 1, -3,
+  0, 0, 3, -3, 4, -3, -3, -4, 2, -1, 2, 1, -3, -2, -1, 4,
+  3, 0, 1, 0, 3, 0, 1, 3, -3, -3, 3, -2, 0, 3, -2, -1,
+  -1, 0, 3, 3, -2, -2, 1, -4, -3, 0, 2, 0, -2, -3, -3, -1,
+  -2, -1, -1, -2, 0, 3, -1, -3, 2, -2, -1, 2, -2, 1, -2, 1,
+  -1, 1, 3, 1, -1, 0, -1, -2, -3, -2, 1, -1, 0, 1, 3, -1,
+  0, 0, 2, -1, 2, -2, -2, -1, 1, 0, 1, 1, -2, -1, 2, 1,
+  0, 2, 0, 0, -3, -2, -2, -3, 2, -3, 2, 2, -2, 1, 1, -2,
+  2, -3, 1, 1, 1, -2, 0, 3, -1, 2, 2, -2, -1, 0, -2, 0,
+  -2, -1, 0, 0, -1, -1, 0, 2, 2, -2, 0, 0, 2, 3, -1, -1,
+  -1, -2, -2, 3, 0, -1, -1, -2, 1, -2, 2, 1, -2, -1, -2, 0,
+  2, 2, -2, 0, -2, -1, 2, -1, 0, 1, -1, 2, 0, 0, 0, 0,
+  0, 1, 2, 3, 6, 8, 11, 15, 18, 22, 26, 29, 33, 37, 40, 43,
+  46, 48, 50, 51, 52, 52, 51, 49, 47, 44, 40, 36, 31, 25, 19, 12,
+  5, -3, -11, -20, -28, -37, -46, -54, -62, -69, -75, -80, -84, -87, -90, -92,
+  -93, -93, -93, -92, -90, -87, -83, -79, -75, -69, -64, -57, -51, -44, -37, -29,
+  -22, -14, -6, 2, 9, 16, 24, 30, 37, 43, 49, 54, 59, 63, 66, 69,
+  72, 74, 75, 75, 75, 74, 73, 71, 69, 66, 62, 59, 54, 49, 44, 39,
+  34, 28, 22, 16, 10, 4, -2, -8, -14, -20, -25, -30, -35, -39, -44, -47,
+  -51, -53, -56, -58, -59, -60, -60, -60, -60, -59, -57, -56, -53, -51, -48, -44,
+  -41, -37, -33, -28, -24, -19, -14, -10, -5, 0, 5, 9, 14, 18, 22, 26,
+  30, 33, 36, 39, 41, 43, 45, 46, 47, 48, 48, 48, 48, 47, 46, 44,
+  42, 40, 38, 35, 32, 29, 26, 22, 19, 15, 12, 8, 4, 0, -3, -7,
+  -11, -14, -17, -20, -23, -26, -28, -31, -32, -34, -36, -37, -38, -38, -38, -38,
+  -38, -38, -37, -36, -34, -33, -31, -29, -27, -25, -22, -20, -17, -14, -11, -8,
+  -5, -2, 1, 3, 6, 9, 12, 14, 16, 19, 21, 23, 24, 26, 27, 28,
+  29, 30, 30, 31, 31, 30, 30, 29, 28, 27, 26, 25, 23, 22, 20, 18,
+  16, 14, 12, 10, 7, 5, 3, 1, -2, -4, -6, -8, -10, -12, -14, -15,
+  -17, -18, -20, -21, -22, -23, -23, -24, -24, -24, -24, -24, -24, -23, -22, -22,
+  -21, -20, -18, -17, -16, -14, -13, -11, -9, -8, -6, -4, -2, -1, 1, 3,
+  4, 6, 8, 9, 10, 12, 13, 14, 15, 16, 17, 17, 18, 18, 19, 19,
+  19, 19, 19, 18, 18, 17, 17, 16, 15, 14, 13, 12, 11, 10, 8, 7,
+  6, 4, 3, 2, 0, -1, -2, -3, -5, -6, -7, -8, -9, -10, -11, -12,
+  -12, -13, -14, -14, -14, -15, -15, -15, -15, -15, -14, -14, -14, -13, -13, -12,
+  -11, -11, -10, -9, -8, -7, -6, -5, -4, -3, -2, -1, 0, 1, 2, 3,
+  4, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 11, 11, 11, 12, 12,
+  12, 11, 11, 11, 11, 10, 10, 10, 9, 8, 8, 7, 7, 6, 5, 4,
+  4, 3, 2, 1, 0, 0, -1, -2, -3, -3, -4, -5, -5, -6, -6, -7,
+  -7, -8, -8, -8, -9, -9, -9, -9, -9, -9, -9, -9, -9, -8, -8, -8,
+  -7, -7, -7, -6, -6, -5, -5, -4, -3, -3, -2, -2, -1, -1, 0, 1,
+  1, 2, 2, 3, 3, 4, 4, 5, 5, 5, 6, 6, 6, 6, 7, 7,
+  7, 7, 7, 7, 7, 7, 7, 6, 6, 6, 6, 5, 5, 5, 4, 4,
+  4, 3, 3, 2, 2, 1, 1, 1, 0, 0, -1, -1, -2, -2, -2, -3,
+  -3, -3, -4, -4, -4, -4, -5, -5, -5, -5, -5, -5, -5, -5, -5, -5,
+  -5, -5, -5, -5, -5, -4, -4, -4, -4, -3, -3, -3, -2, -2, -2, -1,
+  -1, -1, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 3, 3, 3, 3,
+  3, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+  3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0,
+  0, 0, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -2, -3, -3, -3,
+  -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -3, -2, -2,
+  -2, -2, -2, -2, -2, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+  1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -2, -2, -2, -2, -2, -2,
+  -2, -2, -2, -2, -2, -2, -2, -2, -2, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+// empty - dry fire click, 40 ms
+static const int8_t PCM_EMPTY[] PROGMEM = {
+  31, 8, 115, -112, 41, -80, -75, 30, -94, 73, -52, -58, -88, -47, -49, -62,
+  -75, 8, -10, -73, 63, 37, -41, 10, 66, 26, -29, 55, -17, -26, -47, 34,
+  3, -11, 6, 10, 37, 13, -38, 21, -21, 42, -40, 26, -26, 11, 10, 26,
+  36, 26, -33, 13, 33, 29, -3, -21, 23, 28, -20, -21, 27, -15, -20, -13,
+  26, -16, -22, 19, 9, -21, -16, -21, 7, 18, -19, -19, -12, -17, -16, -1,
+  15, -2, -8, -1, 11, 12, 9, 2, 3, -8, 7, -2, -12, 7, 5, -1,
+  5, -2, -8, -7, -7, -4, -6, 4, -8, 4, 7, -8, 7, -3, 3, 5,
+  -6, 2, -2, 3, 5, -5, -1, -1, -4, -2, 3, -3, 5, 5, -2, -2,
+  2, -3, 1, -2, -3, 0, -2, -2, 1, -2, 1, 1, 1, 1, -1, -2,
+  -1, -3, -3, 1, 2, 3, 1, 3, 3, 2, 1, 3, -2, 0, -2, -2,
+  -1, -1, 2, -1, -1, 0, 0, 0, 1, 1, 2, 0, 1, 1, 1, 0,
+  0, 0, 0, 1, -1, 0, -1, 1, 1, 0, 0, -1, 1, 0, 1, 0,
+  0, -1, 0, -1, 0, 1, -1, 0, 0, 1, 1, -1, 0, 0, -1, 0,
+  1, -1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// 11680 bytes of samples
+static const EasyPcmSound PCM_SOUNDS[] PROGMEM = {
+  {AUDIO_TRACK_START_UP, PCM_START_UP, sizeof(PCM_START_UP)},
+  {AUDIO_TRACK_AMMO_CHANGE_MODE, PCM_CHANGE_MODE, sizeof(PCM_CHANGE_MODE)},
+  {AUDIO_TRACK_AMMO_FIRE_A, PCM_FIRE_A, sizeof(PCM_FIRE_A)},
+  {AUDIO_TRACK_AMMO_FIRE_B, PCM_FIRE_B, sizeof(PCM_FIRE_B)},
+  {AUDIO_TRACK_AMMO_STUN_A, PCM_STUN_A, sizeof(PCM_STUN_A)},
+  {AUDIO_TRACK_AMMO_STUN_B, PCM_STUN_B, sizeof(PCM_STUN_B)},
+  {AUDIO_TRACK_AMMO_RELOAD, PCM_RELOAD, sizeof(PCM_RELOAD)},
+  {AUDIO_TRACK_AMMO_EMPTY, PCM_EMPTY, sizeof(PCM_EMPTY)},
+};
+static const uint8_t PCM_SOUND_COUNT = sizeof(PCM_SOUNDS) / sizeof(PCM_SOUNDS[0]);
+
+#endif